@@ -0,0 +1,504 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "bench.h"
+#include "../board/board.h"
+#include "../rng/rng.h"
+#include "../stats/stats.h"
+#include "../win_batch/win_batch.h"
+#include "../ultimate/ultimate.h"
+#include "../terminal/terminal.h"
+#include "../console_ui/console_ui.h"
+#include "../output_sink/output_sink.h"
+#include "../player/player.h"
+
+Bench::Bench(int argc, char **argv)
+    : name(0)
+    , size(3)
+    , k(0)
+    , count(1 << 16)
+    , rounds(100)
+    , depth(6)
+{
+    for (int i = 0; i < argc; i++) {
+        int *opt = 0;
+
+        if (strcmp(argv[i], "--size") == 0) { opt = &size; }
+        else if (strcmp(argv[i], "--k") == 0) { opt = &k; }
+        else if (strcmp(argv[i], "--count") == 0) { opt = &count; }
+        else if (strcmp(argv[i], "--rounds") == 0) { opt = &rounds; }
+        else if (strcmp(argv[i], "--depth") == 0) { opt = &depth; }
+        else if (argv[i][0] == '-') { throw "Unknown option"; }
+        else if (name) { throw "Only one benchmark at a time"; }
+        else { name = argv[i]; }
+
+        if (opt) {
+            if (++i >= argc || (*opt = atoi(argv[i])) <= 0) { 
+                throw "Bad option value"; 
+            }
+        }
+    }
+
+    if (!name) { throw "Missing benchmark name"; }
+    if (k == 0) { k = size; }
+}
+
+void Bench::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s bench NAME [options]\n"
+            "  win                  batched win detection vs one board "
+            "at a time\n"
+            "  ultimate             perft of ultimate tic-tac-toe, "
+            "bitboards vs cell scan\n"
+            "  terminal             tcsetattr calls of the mode switches "
+            "of a game\n"
+            "  render               frames/s of the console UI, linear "
+            "and screen\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --count N            items per round (65536)\n"
+            "  --rounds N           repetitions, games of terminal and "
+            "render (100)\n"
+            "  --depth N            plies of a perft (6)\n", name);
+}
+
+int Bench::Run()
+{
+    if (strcmp(name, "win") == 0) { return Win(); }
+    if (strcmp(name, "ultimate") == 0) { return Perft(); }
+    if (strcmp(name, "terminal") == 0) { return TerminalModes(); }
+    if (strcmp(name, "render") == 0) { return Render(); }
+
+    fprintf(stderr, "Unknown benchmark %s\n", name);
+    return 1;
+}
+
+int Bench::Win()
+{
+    Board board(size, k);
+    WinBatch batch(board);
+    Rng rng;
+    uint64_t *masks = new uint64_t[count];
+    uint16_t *masks16 = new uint16_t[count];
+    uint8_t *expect = new uint8_t[count];
+    uint8_t *win = new uint8_t[count];
+    uint64_t base_ns = 0;
+    int res = 0;
+
+    /* Positions of random games cut at a random ply */
+    for (int i = 0; i < count; i++) {
+        int plies = rng.Below(board.GetCellCount() + 1);
+
+        board.Clear();
+        while (board.GetMoveCount() < plies) { board.Make(board.RandomFree(rng)); }
+
+        masks[i] = board.GetMask(rng.Below(2));
+        masks16[i] = static_cast<uint16_t>(masks[i]);
+    }
+
+    printf("win detection, %dx%d k=%d, %d lines, %d boards x %d rounds\n",
+           size, size, k, board.GetLineCount(), count, rounds);
+
+    for (int impl = -1; impl <= WinBatch::avx2; impl++) {
+        const char *label;
+        uint64_t start, ns;
+
+        if (impl >= 0 && !batch.SetIsa(static_cast<WinBatch::isa>(impl))) { 
+            continue; 
+        }
+
+        start = Stats::Now();
+        for (int r = 0; r < rounds; r++) {
+            if (impl < 0) {
+                /* A full scan per board, as Board::IsWin does */
+                for (int i = 0; i < count; i++) {
+                    uint8_t w = 0;
+                    for (int l = 0; l < board.GetLineCount(); l++) {
+                        uint64_t line = board.GetLine(l);
+                        if ((masks[i] & line) == line) { 
+                            w = 1; 
+                            break; 
+                        }
+                    }
+                    expect[i] = w;
+                }
+            }
+            else if (batch.IsNarrow()) { batch.Check(masks16, count, win); }
+            else { batch.Check(masks, count, win); }
+
+            /* Keep the result alive between rounds */
+            __asm__ __volatile__("" : : "r"(win), "r"(expect) : "memory");
+        }
+        ns = Stats::Now() - start;
+
+        if (impl < 0) {
+            base_ns = ns;
+            label = "per board";
+        }
+        else {
+            label = WinBatch::IsaName(static_cast<WinBatch::isa>(impl));
+            if (memcmp(win, expect, count) != 0) {
+                fprintf(stderr, "%s: results differ from per board\n", label);
+                res = 1;
+            }
+        }
+
+        printf("%-10s %s %8.1f Mboards/s %6.2fx\n", label, 
+               impl >= 0 && batch.IsNarrow() ? "16-bit" : "64-bit",
+               static_cast<double>(count) * rounds / ns * 1e3, 
+               static_cast<double>(base_ns) / ns);
+    }
+
+    delete[] win;
+    delete[] expect;
+    delete[] masks16;
+    delete[] masks;
+
+    return res;
+}
+
+/**
+ * @brief Three marks of the side in a line of the 3x3 board.
+ * 
+ * @param at Mark of a cell (0 free, 1, 2) by its index 0-8.
+ */
+static bool ScanLine(const int *at, int mark)
+{
+    static const int lines[8][3] = {
+        { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 },
+        { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 },
+        { 0, 4, 8 }, { 2, 4, 6 }
+    };
+
+    for (int l = 0; l < 8; l++) {
+        if (at[lines[l][0]] == mark && at[lines[l][1]] == mark && 
+            at[lines[l][2]] == mark) { 
+            return true; 
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Legal moves of ultimate tic-tac-toe found cell by cell.
+ * 
+ * Reads only Ultimate::GetMark and the last move, as a board without
+ * masks would: the state of every local board is rescanned.
+ */
+static int ScanMoves(const Ultimate &game, int *moves)
+{
+    int at[9][9], meta[9], open[9];
+    int last = game.GetLastMove(), count = 0;
+
+    for (int b = 0; b < 9; b++) {
+        bool full = true;
+
+        for (int c = 0; c < 9; c++) {
+            at[b][c] = game.GetMark(b * 9 + c);
+            if (!at[b][c]) { full = false; }
+        }
+        meta[b] = ScanLine(at[b], 1) ? 1 : ScanLine(at[b], 2) ? 2 : 0;
+        open[b] = !meta[b] && !full;
+    }
+
+    if (ScanLine(meta, 1) || ScanLine(meta, 2)) { return 0; }
+
+    for (int b = 0; b < 9; b++) {
+        bool forced = last != -1 && open[last % 9];
+
+        if (!open[b] || (forced && b != last % 9)) { continue; }
+        for (int c = 0; c < 9; c++) {
+            if (!at[b][c]) { moves[count++] = b * 9 + c; }
+        }
+    }
+
+    return count;
+}
+
+static long long ScanPerft(Ultimate &game, int depth)
+{
+    int moves[Ultimate::cell_count];
+    int count;
+    long long nodes = 0;
+
+    if (depth == 0) { return 1; }
+
+    count = ScanMoves(game, moves);
+    if (count == 0) { return 1; }
+    if (depth == 1) { return count; }
+
+    for (int i = 0; i < count; i++) {
+        game.Make(moves[i]);
+        nodes += ScanPerft(game, depth - 1);
+        game.Unmake();
+    }
+
+    return nodes;
+}
+
+int Bench::Perft()
+{
+    Ultimate game;
+    int res = 0;
+
+    printf("ultimate tic-tac-toe perft\n");
+    printf("%5s %14s %12s %12s %7s\n", 
+           "depth", "nodes", "bitboard/s", "scan/s", "speedup");
+
+    for (int d = 1; d <= depth; d++) {
+        uint64_t start, bit_ns, scan_ns;
+        long long nodes, expect;
+
+        start = Stats::Now();
+        nodes = game.Perft(d);
+        bit_ns = Stats::Now() - start + 1;
+
+        start = Stats::Now();
+        expect = ScanPerft(game, d);
+        scan_ns = Stats::Now() - start + 1;
+
+        printf("%5d %14lld %11.1fM %11.1fM %6.2fx\n", d, nodes,
+               static_cast<double>(nodes) / bit_ns * 1e3,
+               static_cast<double>(expect) / scan_ns * 1e3,
+               static_cast<double>(scan_ns) / bit_ns);
+
+        if (nodes != expect) {
+            fprintf(stderr, "depth %d: scan counts %lld\n", d, expect);
+            res = 1;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief The mode switches of a game as each toggle used to make them.
+ * 
+ * @return Number of tcsetattr calls.
+ */
+static long ToggleSession(int fd, int bot_moves)
+{
+    termios modify;
+    long calls = 0;
+
+    tcgetattr(fd, &modify);
+
+    /* Intro: no canonical mode, no echo; then lines with echo */
+    modify.c_lflag &= ~ICANON;
+    modify.c_cc[VTIME] = 0;
+    modify.c_cc[VMIN] = 1;
+    tcsetattr(fd, TCSANOW, &modify);
+    modify.c_lflag &= ~ECHO;
+    tcsetattr(fd, TCSANOW, &modify);
+    modify.c_lflag |= ICANON;
+    tcsetattr(fd, TCSANOW, &modify);
+    modify.c_lflag |= ECHO;
+    tcsetattr(fd, TCSANOW, &modify);
+    calls += 4;
+
+    /* The bot types its moves without echo */
+    for (int i = 0; i < bot_moves; i++) {
+        modify.c_lflag &= ~ECHO;
+        tcsetattr(fd, TCSANOW, &modify);
+        modify.c_lflag |= ECHO;
+        tcsetattr(fd, TCSANOW, &modify);
+        calls += 2;
+    }
+
+    return calls;
+}
+
+/**
+ * @brief The same switches through Terminal::Apply, as Game makes them.
+ * 
+ * @return Number of tcsetattr calls, without the restore on exit.
+ */
+static long ApplySession(int fd, int bot_moves)
+{
+    Terminal term(fd);
+
+    term.Apply(Terminal::raw, 0, 1);
+    term.Apply(Terminal::cooked);
+
+    for (int i = 0; i < bot_moves; i++) {
+        Terminal::Scope quiet(term, Terminal::canon);
+    }
+
+    return term.GetSyscalls();
+}
+
+int Bench::TerminalModes()
+{
+    int bot_moves = size * size / 2;
+    int master, slave;
+    termios origin, after;
+    const char *path;
+    long calls[2] = { 0, 0 };
+    uint64_t ns[2];
+    int res = 0;
+
+    /* A pseudo-terminal: the same syscalls as a real one, no screen */
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master == -1 || grantpt(master) || unlockpt(master) || 
+        !(path = ptsname(master)) || 
+        (slave = open(path, O_RDWR | O_NOCTTY)) == -1) {
+        perror("pty");
+        if (master != -1) { close(master); }
+        return 1;
+    }
+    tcgetattr(slave, &origin);
+
+    printf("terminal modes, %d games of %d bot moves on a pty\n", 
+           rounds, bot_moves);
+
+    for (int impl = 0; impl < 2; impl++) {
+        uint64_t start = Stats::Now();
+
+        for (int r = 0; r < rounds; r++) {
+            tcsetattr(slave, TCSANOW, &origin);
+            calls[impl] += impl == 0 ? ToggleSession(slave, bot_moves) 
+                                     : ApplySession(slave, bot_moves);
+        }
+        ns[impl] = Stats::Now() - start + 1;
+
+        tcgetattr(slave, &after);
+        if (impl == 0) { tcsetattr(slave, TCSANOW, &origin); }
+        else if ((after.c_lflag & (ICANON | ECHO)) != 
+                 (origin.c_lflag & (ICANON | ECHO))) {
+            fprintf(stderr, "apply: the mode is not restored\n");
+            res = 1;
+        }
+    }
+
+    printf("%-8s %10s %12s\n", "", "calls/game", "us/game");
+    printf("%-8s %10.1f %12.2f\n", "toggles", 
+           static_cast<double>(calls[0]) / rounds, 
+           static_cast<double>(ns[0]) / rounds / 1e3);
+    printf("%-8s %10.1f %12.2f %6.2fx fewer calls\n", "apply", 
+           static_cast<double>(calls[1]) / rounds, 
+           static_cast<double>(ns[1]) / rounds / 1e3,
+           static_cast<double>(calls[0]) / (calls[1] ? calls[1] : 1));
+
+    close(slave);
+    close(master);
+
+    return res;
+}
+
+/**
+ * @brief Plays random games on the UI, a frame after each move.
+ * 
+ * @return Number of frames.
+ */
+static long RenderGames(ConsoleUI &ui, int size, int games)
+{
+    Player x("X", 'X'), o("O", 'O');
+    const Player *plr[2] = { &x, &o };
+    int cells = size * size;
+    int *order = new int[cells];
+    char move[32];
+    Rng rng;
+    long frames = 0;
+
+    for (int g = 0; g < games; g++) {
+        ui.ClearField();
+        ui.DeleteAllMove();
+
+        for (int i = 0; i < cells; i++) { order[i] = i; }
+        for (int i = cells - 1; i > 0; i--) {
+            int j = rng.Below(i + 1);
+            int t = order[i];
+            order[i] = order[j];
+            order[j] = t;
+        }
+
+        for (int i = 0; i < cells; i++) {
+            const Player &p = *plr[i % 2];
+            int rowi = order[i] / size, coli = order[i] % size;
+
+            ui.SetMark(rowi, coli, p);
+            snprintf(move, sizeof(move), "%d %c%d,%d", 
+                     i + 1, p.GetMark(), rowi, coli);
+            ui.AddMove(move, sizeof(move));
+
+            ui.Clear();
+            ui.Print(ConsoleUI::game_time, &p);
+            frames++;
+        }
+    }
+
+    delete[] order;
+    return frames;
+}
+
+int Bench::Render()
+{
+    enum { win_rows = 40, win_cols = 120 };
+    static const char *const mode_name[2] = { "linear", "screen" };
+    long frames[2];
+    unsigned long long bytes[2];
+    uint64_t ns[2];
+    int res = 0;
+
+    printf("console UI, %d games on %dx%d, screen window %dx%d\n", 
+           rounds, size, size, win_rows, win_cols);
+
+    for (int mode = 0; mode < 2; mode++) {
+        ConsoleUI ui(size, size, "Bench");
+        NullSink null_sink;
+        MemorySink memory_sink(win_rows, win_cols);
+
+        if (mode == 0) { ui.SetSink(&null_sink); }
+        else {
+            ui.SetSink(&memory_sink);
+            if (!ui.EnterScreen()) {
+                fprintf(stderr, "screen: the sink has no window\n");
+                return 1;
+            }
+        }
+
+        uint64_t start = Stats::Now();
+        frames[mode] = RenderGames(ui, size, rounds);
+        ns[mode] = Stats::Now() - start + 1;
+
+        ui.LeaveScreen(false);
+        bytes[mode] = mode == 0 ? null_sink.GetBytes() 
+                                : memory_sink.GetLength();
+        if (!frames[mode] || !bytes[mode]) { res = 1; }
+    }
+
+    printf("%-8s %12s %12s\n", "", "frames/s", "bytes/frame");
+    for (int mode = 0; mode < 2; mode++) {
+        printf("%-8s %12.0f %12.1f\n", mode_name[mode], 
+               frames[mode] / (ns[mode] / 1e9),
+               static_cast<double>(bytes[mode]) / frames[mode]);
+    }
+
+    return res;
+}
@@ -0,0 +1,79 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_H_SENTRY
+#define BENCH_H_SENTRY
+
+/**
+ * @class Bench
+ * @brief Micro-benchmarks of the engine parts.
+ * 
+ * Each benchmark prints its throughput and checks that the compared
+ * implementations give the same results.
+ */
+class Bench {
+private:
+    const char *name;   /**< Benchmark to run */
+    int size, k;        /**< Board rules */
+    int count;          /**< Items per round */
+    int rounds;         /**< Repetitions of the measurement */
+    int depth;          /**< Plies of a perft */
+
+public:
+    /**
+     * @param argc, argv Benchmark name and options after "bench".
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Bench(int argc, char **argv);
+
+    /**
+     * @return Exit status of the program, non-zero on mismatches.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    /**
+     * @brief Batched win detection (WinBatch) against one board at a time.
+     */
+    int Win();
+
+    /**
+     * @brief Perft of ultimate tic-tac-toe: bitboard move generation
+     *        against a scan of the cells.
+     */
+    int Perft();
+
+    /**
+     * @brief tcsetattr calls of the terminal mode switches of a game:
+     *        one call per toggle against Terminal::Apply.
+     */
+    int TerminalModes();
+
+    /**
+     * @brief Frames per second of ConsoleUI, with no terminal: linear
+     *        frames into a NullSink, screen frames into a MemorySink.
+     */
+    int Render();
+};
+
+#endif /* BENCH_H_SENTRY */
@@ -0,0 +1,153 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "board.h"
+
+uint64_t Board::zobrist[2][max_cells];
+pthread_once_t Board::zobrist_once = PTHREAD_ONCE_INIT;
+
+Board::Board(int size, int k)
+    : size(size)
+    , k(k)
+    , cell_count(size * size)
+    , line_count(0)
+    , move_count(0)
+{
+    /* Steps of the rows, columns, diagonals and antidiagonals */
+    static const int drow[4] = { 0, 1, 1,  1 };
+    static const int dcol[4] = { 1, 0, 1, -1 };
+
+    if (size < 1 || size > max_size) { throw "Bad board size"; }
+    if (k < 1 || k > size) { throw "Bad line length"; }
+
+    pthread_once(&zobrist_once, BuildZobrist);
+
+    full = cell_count == 64 ? ~uint64_t(0) : (uint64_t(1) << cell_count) - 1;
+    memset(cell_line_count, 0, sizeof(cell_line_count));
+
+    for (int d = 0; d < 4; d++) {
+        /* With k == 1 every direction gives the same lines */
+        if (k == 1 && d > 0) { break; }
+
+        for (int r = 0; r < size; r++) {
+            for (int c = 0; c < size; c++) {
+                int er = r + drow[d] * (k - 1);
+                int ec = c + dcol[d] * (k - 1);
+                if (er < 0 || er >= size || ec < 0 || ec >= size) { continue; }
+
+                uint64_t m = 0;
+                for (int i = 0; i < k; i++) {
+                    int cell = (r + drow[d] * i) * size + c + dcol[d] * i;
+                    m |= uint64_t(1) << cell;
+                    cell_line[cell][cell_line_count[cell]++] = line_count;
+                }
+                line[line_count++] = m;
+            }
+        }
+    }
+
+    Clear();
+}
+
+void Board::BuildZobrist()
+{
+    /* Fixed keys, so hashes are reproducible */
+    Rng rng(0x7474742d6466706eULL);
+    for (int side = 0; side < 2; side++) {
+        for (int cell = 0; cell < max_cells; cell++) {
+            zobrist[side][cell] = rng.Next();
+        }
+    }
+}
+
+bool Board::IsWinAt(int cell) const
+{
+    int side = mask[0] >> cell & 1 ? 0 : 1;
+
+    for (int i = 0; i < cell_line_count[cell]; i++) {
+        if (line_marks[side][cell_line[cell][i]] == k) { return true; }
+    }
+
+    return false;
+}
+
+bool Board::IsWin(int side) const
+{
+    for (int i = 0; i < line_count; i++) {
+        if ((mask[side] & line[i]) == line[i]) { return true; }
+    }
+
+    return false;
+}
+
+void Board::Clear()
+{
+    mask[0] = mask[1] = 0;
+    hash = 0;
+    move_count = 0;
+    memset(line_marks, 0, sizeof(line_marks));
+
+    for (int i = 0; i < cell_count; i++) {
+        free_cell[i] = i;
+        free_pos[i] = i;
+    }
+    free_count = cell_count;
+}
+
+bool Board::SetPosition(uint64_t mask0, uint64_t mask1)
+{
+    int n0 = __builtin_popcountll(mask0), n1 = __builtin_popcountll(mask1);
+
+    Clear();
+
+    if ((mask0 & mask1) || ((mask0 | mask1) & ~full)) { return false; }
+    if (n0 != n1 && n0 != n1 + 1) { return false; }
+
+    while (mask0 | mask1) {
+        uint64_t &m = GetTurn() ? mask1 : mask0;
+        Make(__builtin_ctzll(m));
+        m &= m - 1;
+    }
+
+    return true;
+}
+
+int Board::ParseMove(const char *str) const
+{
+    if (str[0] < '0' || str[0] > '9') { return -1; }
+    if (str[1] < '0' || str[1] > '9') { return -1; }
+    if (str[2] != '\0') { return -1; }
+
+    int r = str[0] - '0';
+    int c = str[1] - '0';
+    if (r >= size || c >= size) { return -1; }
+
+    int cell = r * size + c;
+    return IsFree(cell) ? cell : -1;
+}
+
+void Board::FormatMove(int cell, char *buff) const
+{
+    buff[0] = '0' + cell / size;
+    buff[1] = '0' + cell % size;
+    buff[2] = '\0';
+}
@@ -0,0 +1,229 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOARD_H_SENTRY
+#define BOARD_H_SENTRY
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "../rng/rng.h"
+
+/**
+ * @class Board
+ * @brief Bitboard of a size x size field with k-in-a-row rules.
+ * 
+ * Each side has a mask of its marks, bit (row * size + col) is a cell.
+ * Moves are applied and taken back in O(1), so a search never copies
+ * the field. The side to move alternates, side 0 moves first.
+ * 
+ * Along with the masks a move updates the history, the Zobrist hash
+ * of the position and the number of marks of its side in every line
+ * through the cell; taking it back reverts all of them.
+ */
+class Board {
+public:
+    enum { 
+        max_size = 8, 
+        max_cells = max_size * max_size,
+        max_lines = 4 * max_cells,      /**< Upper bound of all lines */
+        max_cell_lines = 4 * max_size   /**< Lines through one cell   */
+    };
+
+private:
+    int size;                   /**< Rows (and columns) of the field */
+    int k;                      /**< Marks in a row to win           */
+    int cell_count;             /**< size * size                     */
+    uint64_t full;              /**< Mask of all cells               */
+
+    int line_count;
+    uint64_t line[max_lines];   /**< Masks of all winning lines */
+
+    /** Indexes of Board::line that pass through a cell */
+    unsigned short cell_line[max_cells][max_cell_lines];
+    int cell_line_count[max_cells];
+
+    /** Keys of the marks, the same for all boards and runs */
+    static uint64_t zobrist[2][max_cells];
+    static pthread_once_t zobrist_once;
+    static void BuildZobrist();
+
+    uint64_t mask[2];           /**< Marks of each side */
+    uint64_t hash;              /**< Xor of Board::zobrist of the marks */
+    unsigned char line_marks[2][max_lines];     /**< Marks of a side in a line */
+    int history[max_cells];     /**< Cells in order of moves */
+    int move_count;
+
+    /**
+     * @brief Index of the free cells.
+     * 
+     * free_cell[0; free_count) lists the free cells in any order,
+     * free_pos[cell] is the position of a cell in that list.
+     * A move swaps its cell with the last free one, and the take back
+     * swaps them back, so both are O(1) and the order is restored.
+     */
+    unsigned char free_cell[max_cells];
+    unsigned char free_pos[max_cells];
+    int free_count;
+
+public:
+    /**
+     * @param size Field size, [1; Board::max_size].
+     * @param k Marks in a row to win, [1; size].
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Board(int size = 3, int k = 3);
+
+    int GetSize() const { return size; }
+    int GetK() const { return k; }
+    int GetCellCount() const { return cell_count; }
+    int GetMoveCount() const { return move_count; }
+    int GetLineCount() const { return line_count; }
+    uint64_t GetLine(int i) const { return line[i]; }
+
+    /** @return Number of lines that pass through the cell. */
+    int GetCellLineCount(int cell) const { return cell_line_count[cell]; }
+
+    /** @return Marks of the side in the line, up to Board::GetK. */
+    int GetLineMarks(int side, int i) const { return line_marks[side][i]; }
+
+    /** @return Zobrist hash of the marks (0 for the empty field). */
+    uint64_t GetHash() const { return hash; }
+
+    /** @return Key of a mark, Board::GetHash is the xor of them. */
+    static uint64_t GetKey(int side, int cell) { return zobrist[side][cell]; }
+
+    /** @return 0 or 1, index of the side to move. */
+    int GetTurn() const { return move_count & 1; }
+    uint64_t GetMask(int side) const { return mask[side]; }
+    uint64_t GetFree() const { return full & ~(mask[0] | mask[1]); }
+    bool IsFree(int cell) const { return GetFree() >> cell & 1; }
+    bool IsFull() const { return move_count == cell_count; }
+    int GetFreeCount() const { return free_count; }
+
+    /** @return Free cell at index [0; Board::GetFreeCount). */
+    int GetFreeCell(int i) const { return free_cell[i]; }
+
+    /**
+     * @brief Uniformly chosen free cell in O(1).
+     * 
+     * @note The field must not be full.
+     */
+    int RandomFree(Rng &rng) const { return free_cell[rng.Below(free_count)]; }
+
+    /** @return The last made move, -1 if there are no moves. */
+    int GetLastMove() const 
+        { return move_count ? history[move_count - 1] : -1; }
+
+    /** @return Cell of the move at index [0; Board::GetMoveCount). */
+    int GetMove(int i) const { return history[i]; }
+
+    /**
+     * @brief Places a mark of the side to move.
+     * 
+     * @param cell Free cell (row * size + col), is not checked.
+     */
+    void Make(int cell)
+    {
+        int side = move_count & 1;
+        int pos = free_pos[cell];
+        int last = free_cell[--free_count];
+
+        free_cell[pos] = last;
+        free_pos[last] = pos;
+
+        for (int i = 0; i < cell_line_count[cell]; i++) {
+            line_marks[side][cell_line[cell][i]]++;
+        }
+
+        mask[side] |= uint64_t(1) << cell;
+        hash ^= zobrist[side][cell];
+        history[move_count++] = cell;
+    }
+
+    /**
+     * @brief Takes back the last move.
+     */
+    void Unmake()
+    {
+        int cell = history[--move_count];
+        int pos = free_pos[cell];
+        int moved = free_cell[pos];
+
+        free_cell[free_count] = moved;
+        free_pos[moved] = free_count++;
+        free_cell[pos] = cell;
+
+        int side = move_count & 1;
+        for (int i = 0; i < cell_line_count[cell]; i++) {
+            line_marks[side][cell_line[cell][i]]--;
+        }
+
+        mask[side] &= ~(uint64_t(1) << cell);
+        hash ^= zobrist[side][cell];
+    }
+
+    /**
+     * @brief Checks if a mark in the cell completes a line of its side.
+     * 
+     * @param cell Occupied cell, usually Board::GetLastMove.
+     */
+    bool IsWinAt(int cell) const;
+
+    /**
+     * @brief Checks if the side has a complete line anywhere.
+     */
+    bool IsWin(int side) const;
+
+    /**
+     * @brief Removes all marks.
+     */
+    void Clear();
+
+    /**
+     * @brief Replaces the position with the marks of both sides.
+     * 
+     * The moves are replayed in the order of cells, side 0 first.
+     * 
+     * @return false if the masks overlap or side 0 has neither as many
+     *         marks as side 1 nor one more (the field is cleared).
+     */
+    bool SetPosition(uint64_t mask0, uint64_t mask1);
+
+    /**
+     * @brief Parses a move in the "<row><col>" form, e.g. "11".
+     * 
+     * Rows and columns are single digits, which is enough for
+     * Board::max_size.
+     * 
+     * @return Cell index, -1 if the move is invalid or busy.
+     */
+    int ParseMove(const char *str) const;
+
+    /**
+     * @brief Writes a move in the "<row><col>" form.
+     * 
+     * @param[out] buff Output buffer (size at least 3).
+     */
+    void FormatMove(int cell, char *buff) const;
+};
+
+#endif /* BOARD_H_SENTRY */
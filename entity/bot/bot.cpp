@@ -23,205 +23,344 @@
 #include <time.h>
 
 #include "bot.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
+
+/**
+ * @brief Monotonic clock in microseconds.
+ */
+static long long NowUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
 
 Bot::Bot(const char *nickname, char mark) 
     : Player(nickname, mark)
-    , ui(0) 
+    , level(rules)
+    , table(0)
+    , prover(0)
+    , nodes(0)
+    , node_limit(0)
+    , deadline(0)
+    , stop(0)
+    , aborted(false)
+    , polls(0)
 {
-    memset(move_stat, 0, sizeof(move_stat));
-    srand(time(NULL));
+    memset(&level_limits, 0, sizeof(level_limits));
 }
 
-void Bot::Move(const ConsoleUI &ui, int &rowi, int &coli)
+Bot::~Bot()
 {
-    field_line line;
-    char mark;
+    delete prover;
+    delete table;
+}
 
-    this->ui = &ui;
-    StatDeterm();
+int Bot::Search(Board &board, const search_limits &limits, const int *stop,
+                info_handler handler, void *data)
+{
+    int cells = board.GetCellCount();
+    int empty = cells - board.GetMoveCount();
+    int last = board.GetLastMove();
+    int best = -1;
+    long long start = NowUs();
 
-    if (IsFirstMove()) {
-        if (rand() % 4 < 2 && !ui.IsBusy(1, 1, mark)) {
-            rowi = 1;
-            coli = 1;
-        }
-        else { RandomMove(rowi, coli);}
+    if (empty == 0 || (last != -1 && board.IsWinAt(last))) { return -1; }
 
-        return;
-    }
+    Prepare(board, limits, stop, start);
 
-    if (IsCurrentMoveWin(line)) {
-        FillLine(rowi, coli, line);
-        return;
+    for (int i = 0; i < cells; i++) {
+        if (board.IsFree(order[i])) { 
+            best = order[i]; 
+            break; 
+        }
     }
 
-    if (IsNextMoveLoss(line)) {
-        FillLine(rowi, coli, line);
-        return;
-    }
+    int max_depth = limits.depth > 0 && limits.depth < empty 
+                  ? limits.depth : empty;
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        TraceSpan span("Bot::Search iteration", "depth", depth);
+        int iter_best = best;
+        int score = Negamax(board, depth, 0, -score_win, score_win, 
+                            &iter_best);
+        if (aborted) { break; }
+
+        best = iter_best;
+
+        if (handler) {
+            search_info info;
+            info.depth = depth;
+            info.score = score;
+            info.best = best;
+            info.nodes = nodes;
+            info.time = NowUs() - start;
+            handler(info, data);
+        }
 
-    RandomMove(rowi, coli);
+        if (score > score_proven || score < -score_proven) { break; }
+    }
 
-    return;
+    this->stop = 0;
+    return best;
 }
 
-void Bot::StatDeterm()
+int Bot::Analyze(Board &board, long movetime, int *scores)
 {
-	char own_mark = GetMark();
-    char mark;
-
-    memset(move_stat, 0, sizeof(move_stat));
-
-	for(int i = 0; i < ConsoleUI::row_count; i++) {
-		for(int j = 0; j < ConsoleUI::col_count; j++) {
-			if(ui->IsBusy(i, j, mark)) {
-                if (mark == own_mark) {
-                    if (i == 0) { move_stat[bot][row0]++; }
-                    if (i == 1) { move_stat[bot][row1]++; }
-                    if (i == 2) { move_stat[bot][row2]++; }
-
-                    if (j == 0) { move_stat[bot][col0]++; }
-                    if (j == 1) { move_stat[bot][col1]++; }
-                    if (j == 2) { move_stat[bot][col2]++; }
-                }
-                else {
-                    if (i == 0) { move_stat[man][row0]++; }
-                    if (i == 1) { move_stat[man][row1]++; }
-                    if (i == 2) { move_stat[man][row2]++; }
-
-                    if (j == 0) { move_stat[man][col0]++; }
-                    if (j == 1) { move_stat[man][col1]++; }
-                    if (j == 2) { move_stat[man][col2]++; }
-                }
+    TraceSpan span("Bot::Analyze");
+    int cells = board.GetCellCount();
+    int empty = cells - board.GetMoveCount();
+    int last = board.GetLastMove();
+    int iter[Board::max_cells];
+    int done = 0;
+    search_limits limits;
+
+    if (empty == 0 || (last != -1 && board.IsWinAt(last))) { return 0; }
+
+    memset(&limits, 0, sizeof(limits));
+    limits.movetime = movetime;
+    Prepare(board, limits, 0, NowUs());
+
+    for (int depth = 1; depth <= empty; depth++) {
+        bool proven = true;
+
+        /* Every root move gets the full window, so its score is exact */
+        for (int i = 0; i < cells && !aborted; i++) {
+            int cell = order[i];
+
+            if (!board.IsFree(cell)) { continue; }
+
+            nodes++;
+            board.Make(cell);
+
+            if (board.IsWinAt(cell)) { iter[cell] = score_win - 1; }
+            else if (board.IsFull()) { iter[cell] = 0; }
+            else { 
+                iter[cell] = -Negamax(board, depth - 1, 1, -score_win, 
+                                      score_win, 0); 
+            }
+
+            board.Unmake();
+
+            if (iter[cell] <= score_proven && iter[cell] >= -score_proven) { 
+                proven = false; 
             }
-		}
-	}
-
-	/* Main diagonal */
-	for(int i = 0; i < ConsoleUI::row_count; i++) {
-        if(ui->IsBusy(i, i, mark)) {
-            if (mark == own_mark) { move_stat[bot][d0]++; }
-            else { move_stat[man][d0]++; }
         }
-	}
 
-	/* Secondary diagonal */
-	for(int i = 0; i < ConsoleUI::row_count; i++) {
-        if(ui->IsBusy(i, 2 - i, mark)) {
-            if (mark == own_mark) { move_stat[bot][d1]++; }
-            else { move_stat[man][d1]++; }
+        if (aborted) { break; }
+
+        for (int cell = 0; cell < cells; cell++) {
+            if (board.IsFree(cell)) { scores[cell] = iter[cell]; }
         }
-	}
-}
+        done = depth;
 
-bool Bot::IsFirstMove() const
-{
-    for (int j = 0; j < line_count; j++) {
-        if (move_stat[bot][j] != 0) { return false; }
+        if (proven) { break; }
     }
 
-    return true;
+    return done;
 }
 
-bool Bot::IsCurrentMoveWin(field_line &line) const
+void Bot::Prepare(const Board &board, const search_limits &limits, 
+                  const int *stop, long long start)
 {
-    for (int j = 0; j < line_count; j++) {
-        if (move_stat[bot][j] == 2 && !move_stat[man][j]) {
-            line = static_cast<field_line>(j);
-            return true; 
+    int cells = board.GetCellCount();
+
+    /* Cells on more lines first, the order is stable for equal ones */
+    for (int i = 0; i < cells; i++) { order[i] = i; }
+    for (int i = 1; i < cells; i++) {
+        int cell = order[i], j = i;
+        for (; j > 0 && board.GetCellLineCount(order[j - 1]) < 
+                        board.GetCellLineCount(cell); j--) {
+            order[j] = order[j - 1];
         }
+        order[j] = cell;
     }
 
-    return false;
+    nodes = 0;
+    node_limit = limits.nodes;
+    deadline = limits.movetime > 0 ? start + limits.movetime * 1000 : 0;
+    this->stop = stop;
+    aborted = false;
 }
 
-bool Bot::IsNextMoveLoss(field_line &line) const
+int Bot::Negamax(Board &board, int depth, int ply, 
+                 int alpha, int beta, int *best)
 {
-    for (int j = 0; j < line_count; j++) {
-        if (move_stat[man][j] == 2 && !move_stat[bot][j]) {
-            line = static_cast<field_line>(j);
-            return true; 
+    int cells = board.GetCellCount();
+    int best_score = -score_win;
+    int first = best ? *best : -1;
+
+    if (IsAborted()) { return 0; }
+    if (depth == 0) { return Evaluate(board); }
+
+    /* The best cell of the previous iteration goes first */
+    for (int i = -1; i < cells; i++) {
+        int cell = i < 0 ? first : order[i];
+        int score;
+
+        if (cell < 0 || (i >= 0 && cell == first)) { continue; }
+        if (!board.IsFree(cell)) { continue; }
+
+        nodes++;
+        board.Make(cell);
+
+        if (board.IsWinAt(cell)) { score = score_win - ply - 1; }
+        else if (board.IsFull()) { score = 0; }
+        else { 
+            score = -Negamax(board, depth - 1, ply + 1, -beta, -alpha, 0); 
+        }
+
+        board.Unmake();
+
+        if (aborted) { return 0; }
+
+        if (score > best_score) {
+            best_score = score;
+            if (best) { *best = cell; }
         }
+        if (score > alpha) { alpha = score; }
+        if (alpha >= beta) { break; }
     }
 
-    return false;
+    return best_score;
 }
 
-void Bot::RandomMove(int &rowi, int &coli) const
+int Bot::Evaluate(const Board &board) const
 {
-    int rnd_row, rnd_col;
-    char mark;
+    int me = board.GetTurn();
+    int score = 0;
 
-    for (;;) {
-        rnd_row = rand() % ConsoleUI::row_count;
-        rnd_col = rand() % ConsoleUI::col_count;
+    /* The counters follow every move, no masks to intersect */
+    for (int i = 0; i < board.GetLineCount(); i++) {
+        int own_count = board.GetLineMarks(me, i);
+        int opp_count = board.GetLineMarks(!me, i);
 
-        if (!ui->IsBusy(rnd_row, rnd_col, mark)) {
-            rowi = rnd_row;
-            coli = rnd_col;
-            break;
-        }
+        if (opp_count == 0) { score += own_count * own_count; }
+        if (own_count == 0) { score -= opp_count * opp_count; }
     }
+
+    return score;
 }
 
-void Bot::FillLine(int &rowi, int &coli, field_line line)
+bool Bot::IsAborted()
 {
-    char mark;
-    int i, j;
-
-    if (line >= row0 && line <= row2) {
-        if (line == row0) { i = 0; }
-        if (line == row1) { i = 1; }
-        if (line == row2) { i = 2; }
-
-        for (j = 0; j < ConsoleUI::col_count; j++) {
-            if (!ui->IsBusy(i, j, mark)) {
-                rowi = i;
-                coli = j;
-                break;
-            }
-        }
+    if (aborted) { return true; }
+    if (node_limit && nodes >= node_limit) { aborted = true; }
+    if (stop && __atomic_load_n(stop, __ATOMIC_RELAXED)) { aborted = true; }
 
-        return;
+    /* The clock is slower than a node */
+    if (deadline && (++polls & 1023) == 0 && NowUs() >= deadline) { 
+        aborted = true; 
     }
 
-    if (line >= col0 && line <= col2) {
-        if (line == col0) { j = 0; }
-        if (line == col1) { j = 1; }
-        if (line == col2) { j = 2; }
+    return aborted;
+}
 
-        for (i = 0; i < ConsoleUI::row_count; i++) {
-            if (!ui->IsBusy(i, j, mark)) {
-                rowi = i;
-                coli = j;
-                break;
-            }
-        }
+bool Bot::SetLevel(const char *spec)
+{
+    char *end;
+    long long val;
+
+    if (strcmp(spec, "rules") == 0) { 
+        level = rules;
+        return true;
+    }
+    if (strcmp(spec, "random") == 0) {
+        level = random;
+        return true;
+    }
+    if (strncmp(spec, "table:", 6) == 0) {
+        ValueTable *t;
+
+        try { t = new ValueTable(spec + 6); }
+        catch (const char *) { return false; }
 
-        return;
+        delete table;
+        table = t;
+        level = learned;
+        return true;
     }
 
-    if (line == d0) {
-        for (i = 0; i < ConsoleUI::row_count; i++) {
-            if (!ui->IsBusy(i, i, mark)) {
-                rowi = i;
-                coli = i;
-                break;
+    if (!strchr("dtnp", spec[0]) || spec[0] == '\0') { return false; }
+
+    val = strtoll(spec + 1, &end, 10);
+    if (end == spec + 1 || *end != '\0' || val <= 0) { return false; }
+
+    memset(&level_limits, 0, sizeof(level_limits));
+    if (spec[0] == 'd') { level_limits.depth = val; }
+    if (spec[0] == 't') { level_limits.movetime = val; }
+    if (spec[0] == 'n' || spec[0] == 'p') { level_limits.nodes = val; }
+
+    level = spec[0] == 'p' ? proof : search;
+    if (level == proof && !prover) { prover = new Dfpn(prover_bytes); }
+    return true;
+}
+
+void Bot::SetSeed(uint64_t seed)
+{
+    rng.Seed(seed);
+}
+
+int Bot::Choose(Board &board)
+{
+    StatTimer timer(Stats::bot_move);
+
+    if (board.IsFull()) { return -1; }
+
+    switch (level) {
+        case rules: return RuleMove(board);
+        case random: return board.RandomFree(rng);
+        case search: return Search(board, level_limits, 0);
+        case learned: 
+            if (table->Matches(board)) { 
+                int value;
+                return table->Greedy(board, &rng, value); 
             }
+            return RuleMove(board);
+        case proof: {
+            int best;
+
+            prover->Solve(board, level_limits.nodes, &best);
+            if (best != -1) { return best; }
+            return Search(board, level_limits, 0);
         }
+    }
+
+    return -1;
+}
 
-        return;
+int Bot::RuleMove(const Board &board)
+{
+    uint64_t own = board.GetMask(board.GetTurn());
+    uint64_t opp = board.GetMask(!board.GetTurn());
+    uint64_t free = board.GetFree();
+    int size = board.GetSize();
+    int k = board.GetK();
+
+    if (!own) {
+        int center = size / 2 * size + size / 2;
+
+        if (size % 2 && rng.Below(4) < 2 && (free >> center & 1)) { 
+            return center; 
+        }
+
+        return board.RandomFree(rng);
     }
 
-    if (line == d1) {
-        for (i = 0; i < ConsoleUI::row_count; i++) {
-            if (!ui->IsBusy(i, 2 - i, mark)) {
-                rowi = i;
-                coli = 2 - i;
-                break;
-            }
+    for (int i = 0; i < board.GetLineCount(); i++) {
+        uint64_t line = board.GetLine(i);
+        if (!(line & opp) && __builtin_popcountll(line & own) == k - 1) {
+            return __builtin_ctzll(line & free);
         }
+    }
 
-        return;
+    for (int i = 0; i < board.GetLineCount(); i++) {
+        uint64_t line = board.GetLine(i);
+        if (!(line & own) && __builtin_popcountll(line & opp) == k - 1) {
+            return __builtin_ctzll(line & free);
+        }
     }
+
+    return board.RandomFree(rng);
 }
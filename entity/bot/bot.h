@@ -21,115 +21,199 @@
 #ifndef BOT_H_SENTRY
 #define BOT_H_SENTRY
 
-#include "../console_ui/console_ui.h"
 #include "../player/player.h"
-#include "../player_i.h"
+#include "../board/board.h"
+#include "../rng/rng.h"
+#include "../value_table/value_table.h"
+#include "../dfpn/dfpn.h"
 
 /**
  * @class Bot
  * @brief The computer-controlled participant of the game.
  */
 class Bot : public Player {
-private:
+public:
     /**
-     * @enum field_line 
-     * @brief All lines of the 3x3 field.
-     * 
-     * @see Bot::move_stat
+     * @brief Limits of Bot::Search, 0 means no limit.
      */
-    enum field_line {
-        row0, row1, row2,
-        col0, col1, col2,
-        d0, d1,
-        line_count = 8
+    struct search_limits {
+        int depth;          /**< Plies of the deepest iteration */
+        long movetime;      /**< Milliseconds for the whole search */
+        long long nodes;    /**< Visited positions */
     };
 
     /**
-     * @brief Used to generate Bot::move_stat based 
-     *        on the current playing field.
+     * @brief Result of a completed iteration of Bot::Search.
      */
-    const ConsoleUI *ui;
+    struct search_info {
+        int depth;          /**< Plies of the iteration */
+        int score;          /**< For the side to move, see Bot::score_win */
+        int best;           /**< Best cell of the iteration */
+        long long nodes;    /**< Positions visited since the start */
+        long long time;     /**< Microseconds since the start */
+    };
 
     /**
-     * @brief Statistics of marks on the playing field.
+     * @brief Called after each iteration of Bot::Search.
      * 
-     * First index: player (bot or man).
-     * Second index: line (row, column or diagonal).
-     * Value: number of marks in that line.
+     * @param data Pointer passed to Bot::Search.
+     */
+    typedef void (*info_handler)(const search_info &info, void *data);
+
+    /**
+     * @brief Score of a won position.
      * 
-     * @see enum player_i (first index)
-     * @see Bot::field_line (second index)
+     * A win in n plies is scored score_win - n, a loss -(score_win - n).
+     * Scores with an absolute value above score_proven are exact.
      */
-    int move_stat[player_count][line_count];
+    enum { score_win = 100000, score_proven = score_win - Board::max_cells };
+
+    /**
+     * @enum level_kind
+     * @brief How the bot chooses a move in Bot::Choose.
+     * 
+     * @var rules  Win, block or random cell (the classic bot).
+     * @var random Any free cell.
+     * @var search Bot::Search with Bot::level_limits.
+     * @var learned Greedy move of Bot::table.
+     * @var proof  Bot::prover, Bot::Search if it finds no proof.
+     */
+    enum level_kind { rules, random, search, learned, proof };
+
+private:
+    enum { prover_bytes = 16 << 20 };  /**< Table of Bot::prover */
+
+    level_kind level;               /**< See Bot::SetLevel */
+    search_limits level_limits;     /**< Used if level is search */
+    Rng rng;                        /**< Source of all random choices */
+    ValueTable *table;              /**< Loaded for the learned level */
+    Dfpn *prover;                   /**< Created for the proof level */
+
+    /* Search state, valid during Bot::Search only */
+    long long nodes;            /**< Visited positions */
+    long long node_limit;       /**< 0 - no limit */
+    long long deadline;         /**< Monotonic us, 0 - no limit */
+    const int *stop;            /**< Set to non-zero to abort */
+    bool aborted;               /**< The iteration is incomplete */
+    unsigned polls;             /**< Calls of Bot::IsAborted */
+    int order[Board::max_cells];/**< Cells sorted by number of lines */
 
 public:
     Bot(const char *nickname, char mark);
+    ~Bot();
 
     /**
-     * @brief Generates the bot's next move based on current field state.
+     * @brief Iterative deepening alpha-beta search for the side to move.
+     * 
+     * @param board Position, restored before return.
+     * @param limits Search limits (depth, time, nodes).
+     * @param stop Flag checked during the search, can be NULL.
+     *             The search stops as soon as it becomes non-zero.
+     * @param handler Called after each completed iteration, can be NULL.
+     * @param data Passed to handler.
+     * 
+     * @return Best cell, -1 if the game is over.
      * 
-     * @param ui Game interface for field access.
-     * @param[out] rowi Selected row.
-     * @param[out] coli Selected column.
+     * @note The search ends early if the result of the game is proven.
      */
-    void Move(const ConsoleUI &ui, int &rowi, int &coli);
+    int Search(Board &board, const search_limits &limits, const int *stop,
+               info_handler handler = 0, void *data = 0);
 
-private:
     /**
-     * @brief Determines move statistics by scanning the current field.
+     * @brief Sets the strength of the bot from a text specification.
+     * 
+     * Used by tournaments only; the game and the engine keep the default.
      * 
-     * Counts marks for bot and opponent in each row, column and diagonal.
-     * Results are stored in Bot::move_stat array.
+     * - "rules"  Win, block or random cell (default).
+     * - "random" Any free cell.
+     * - "d<N>"   Search to depth N.
+     * - "t<MS>"  Search for MS milliseconds.
+     * - "n<N>"   Search for N nodes.
+     * - "p<N>"   Proof-number search for N nodes, a winning or
+     *            non-losing move if proven, else a search for N nodes.
+     * - "table:<FILE>" Best move of a value table from "ttt learn",
+     *                  or the rules on boards the table is not for.
+     * 
+     * @return false if the specification is invalid or the table
+     *         can't be loaded.
      */
-    void StatDeterm();
+    bool SetLevel(const char *spec);
 
     /**
-     * @brief Checks whether the current move is the first one.
-     * 
-     * @return true if no bot marks on the game field, false otherwise.
+     * @brief Restarts the random choices of the bot from the seed.
      */
-    bool IsFirstMove() const;
+    void SetSeed(uint64_t seed);
 
     /**
-     * @brief Checks whether the bot can win in the current move.
+     * @brief Scores every free cell for the side to move in one search.
      * 
-     * @param[out] line The line where winning move is possible.
-     * @return true if winning move exists, false otherwise.
+     * Iterative deepening where each root move is searched with the
+     * full window, so all of them get exact scores of the same depth.
+     * It stops when every score is proven or the time is out; the
+     * scores of the last completed iteration are kept. At the depth of
+     * the free cells all of them are exact, draws too.
      * 
-     * @note If return value is false, line contains invalid data.
+     * @param board Position, restored before return.
+     * @param movetime Milliseconds at most.
+     * @param[out] scores By cell, filled for the free cells only
+     *                    (see Bot::score_win).
+     * 
+     * @return Depth of the scores, 0 if the game is over or there was
+     *         no time for one iteration.
      */
-    bool IsCurrentMoveWin(field_line &line) const;
+    int Analyze(Board &board, long movetime, int *scores);
 
     /**
-     * @brief Checks whether the opponent can win in the next move.
+     * @brief Chooses a move for the side to move according to the level.
      * 
-     * @param[out] line The line that needs to be blocked.
-     * @return true if opponent has a winning threat, false otherwise.
+     * @param board Position, restored before return.
+     * @return Selected cell, -1 if the field is full.
+     */
+    int Choose(Board &board);
+
+private:
+    /**
+     * @brief Sets up the move order and the limits of a search.
      * 
-     * @note If return value is false, line contains invalid data.
+     * @param start Time of the start, see NowUs.
      */
-    bool IsNextMoveLoss(field_line &line) const;
+    void Prepare(const Board &board, const search_limits &limits, 
+                 const int *stop, long long start);
 
     /**
-     * @brief Generates a random free cell on the field.
+     * @brief Alpha-beta search in negamax form.
+     * 
+     * @param ply Distance from the root.
+     * @param[out] best Best cell (can be NULL).
      * 
-     * @param[out] rowi Selected row.
-     * @param[out] coli Selected column.
+     * @return Score for the side to move.
+     */
+    int Negamax(Board &board, int depth, int ply, 
+                int alpha, int beta, int *best);
+
+    /**
+     * @brief Static evaluation for the side to move.
      * 
-     * @warning Randomly picks coordinates until an empty cell is found.
+     * Every line without opponent marks gives squared number of own
+     * marks, and vice versa for the opponent.
+     */
+    int Evaluate(const Board &board) const;
+
+    /**
+     * @brief Checks the time, node and stop limits.
      */
-    void RandomMove(int &rowi, int &coli) const;
+    bool IsAborted();
 
     /**
-     * @brief Finds a free cell in the specified line.
+     * @brief Win, block or random cell on a board of any size.
      * 
-     * @param[out] rowi Selected row.
-     * @param[out] coli Selected column.
-     * @param line The line to search for a free cell.
+     * The first move takes the center with 50% probability, then
+     * a line of k - 1 own marks is completed, then a line of k - 1
+     * opponent marks is blocked, otherwise a random cell is taken.
      * 
-     * @note If no free cell in the line, output values are undefined.
+     * @return Selected cell.
      */
-    void FillLine(int &rowi, int &coli, field_line line);
+    int RuleMove(const Board &board);
 };
 
 #endif /* BOT_H_SENTRY */
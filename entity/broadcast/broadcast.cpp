@@ -0,0 +1,350 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "broadcast.h"
+
+Broadcast::Broadcast(const char *name, const Variant &variant)
+    : shm(0)
+{
+    int fd;
+    void *mem;
+
+    GetPath(name, path, sizeof(path));
+    if (variant.GetRows() * variant.GetCols() > max_cells) {
+        throw "The field is too large to publish";
+    }
+
+    fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    /* Only an object of an ended or crashed game is replaced */
+    if (fd == -1 && errno == EEXIST) {
+        if (!IsStale(path)) { throw "Name is in use"; }
+        shm_unlink(path);
+        fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd == -1) { throw "Can't create the shared memory of the game"; }
+
+    if (ftruncate(fd, sizeof(layout)) == -1 || 
+        (mem = mmap(0, sizeof(layout), PROT_READ | PROT_WRITE, MAP_SHARED, 
+                    fd, 0)) == MAP_FAILED) {
+        close(fd);
+        shm_unlink(path);
+        throw "Can't map the shared memory of the game";
+    }
+    close(fd);
+
+    /* Zero-filled by ftruncate */
+    shm = static_cast<layout *>(mem);
+    shm->rows = variant.GetRows();
+    shm->cols = variant.GetCols();
+    shm->block_rows = variant.GetBlockRows();
+    shm->block_cols = variant.GetBlockCols();
+    strncpy(shm->title, variant.GetTitle(), name_size - 1);
+    if (variant.GetBlockLabel()) {
+        strncpy(shm->block_label, variant.GetBlockLabel(), name_size - 1);
+    }
+    shm->snap.last_row = shm->snap.last_col = -1;
+    shm->snap.panel_plr = no_player;
+    shm->pid = getpid();
+
+    __atomic_store_n(&shm->magic, layout_magic, __ATOMIC_RELEASE);
+}
+
+Broadcast::~Broadcast()
+{
+    __atomic_store_n(&shm->closed, 1, __ATOMIC_RELEASE);
+    munmap(shm, sizeof(layout));
+    shm_unlink(path);
+}
+
+bool Broadcast::IsStale(const char *path)
+{
+    int fd = shm_open(path, O_RDONLY, 0);
+    struct stat st;
+    void *mem;
+    bool res;
+
+    /* Removed meanwhile: nothing to take over */
+    if (fd == -1) { return errno == ENOENT; }
+
+    if (fstat(fd, &st) == -1 || 
+        st.st_size != static_cast<off_t>(sizeof(layout)) ||
+        (mem = mmap(0, sizeof(layout), PROT_READ, MAP_SHARED, fd, 0)) == 
+        MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    close(fd);
+
+    const layout *old = static_cast<const layout *>(mem);
+
+    if (__atomic_load_n(&old->magic, __ATOMIC_ACQUIRE) != layout_magic) { 
+        res = false; 
+    }
+    else if (__atomic_load_n(&old->closed, __ATOMIC_ACQUIRE)) { res = true; }
+    else { res = kill(old->pid, 0) == -1 && errno == ESRCH; }
+
+    munmap(mem, sizeof(layout));
+    return res;
+}
+
+void Broadcast::GetPath(const char *name, char *path, size_t size)
+{
+    if (!*name || strchr(name, '/') || strlen(name) + 6 > size) {
+        throw "A game name is a short word without '/'";
+    }
+    snprintf(path, size, "/ttt-%s", name);
+}
+
+void Broadcast::SetPlayers(const Player &first, const Player &second)
+{
+    const Player *plr[2] = { &first, &second };
+
+    /* Before the events, the readers take them at any time */
+    for (int i = 0; i < 2; i++) {
+        memset(shm->names[i], 0, name_size);
+        strncpy(shm->names[i], plr[i]->GetNickname(), name_size - 1);
+        shm->marks[i] = plr[i]->GetMark();
+    }
+}
+
+void Broadcast::Reset()
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = reset;
+    Publish(e);
+}
+
+void Broadcast::Mark(int row, int col, int plr)
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = mark;
+    e.plr = plr;
+    e.row = row;
+    e.col = col;
+    Publish(e);
+}
+
+void Broadcast::Unmark(int row, int col)
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = unmark;
+    e.row = row;
+    e.col = col;
+    Publish(e);
+}
+
+void Broadcast::Line(int move_count, int plr, const char *text)
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = line;
+    e.plr = plr;
+    e.move_count = move_count;
+    strncpy(e.text, text, text_size - 1);
+    Publish(e);
+}
+
+void Broadcast::ClearLines()
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = clear_lines;
+    Publish(e);
+}
+
+void Broadcast::Panel(int version, int plr)
+{
+    event e;
+
+    memset(&e, 0, sizeof(e));
+    e.type = panel;
+    e.plr = plr;
+    e.row = version;
+    Publish(e);
+}
+
+void Broadcast::Publish(event &e)
+{
+    uint64_t seq = shm->head;
+    event &slot = shm->ring[seq & (ring_size - 1)];
+    uint32_t lock = shm->snap_lock;
+
+    /* A reader copying the old event sees the slot change */
+    __atomic_store_n(&slot.seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    e.seq = 0;
+    memcpy(&slot, &e, sizeof(e));
+    __atomic_store_n(&slot.seq, seq + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&shm->head, seq + 1, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&shm->snap_lock, lock + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    Apply(shm->snap, e, shm->cols);
+    shm->snap.next = seq + 1;
+    __atomic_store_n(&shm->snap_lock, lock + 2, __ATOMIC_RELEASE);
+}
+
+void Broadcast::Apply(snapshot &s, const event &e, int cols)
+{
+    switch (e.type) {
+        case reset:
+            memset(s.marks, 0, sizeof(s.marks));
+            s.last_row = s.last_col = -1;
+            s.line_count = 0;
+            break;
+
+        case mark:
+            s.marks[e.row * cols + e.col] = e.plr + 1;
+            s.last_row = e.row;
+            s.last_col = e.col;
+            break;
+
+        case unmark:
+            s.marks[e.row * cols + e.col] = 0;
+            if (e.row == s.last_row && e.col == s.last_col) {
+                s.last_row = s.last_col = -1;
+            }
+            break;
+
+        case line:
+            /* Full: the oldest line makes room */
+            if (s.line_count == history_size) {
+                memmove(s.lines, s.lines + 1, 
+                        (history_size - 1) * sizeof(event));
+                s.line_count--;
+            }
+            s.lines[s.line_count++] = e;
+            break;
+
+        case clear_lines:
+            s.line_count = 0;
+            break;
+
+        case panel:
+            s.panel = e.row;
+            s.panel_plr = e.plr;
+            break;
+    }
+}
+
+BroadcastReader::BroadcastReader(const char *name)
+    : shm(0)
+    , next(0)
+{
+    char path[Broadcast::name_size + 8];
+    struct stat st;
+    int fd;
+    void *mem;
+
+    Broadcast::GetPath(name, path, sizeof(path));
+
+    fd = shm_open(path, O_RDONLY, 0);
+    if (fd == -1) { throw "No such game is published"; }
+
+    if (fstat(fd, &st) == -1 || 
+        st.st_size != static_cast<off_t>(sizeof(Broadcast::layout)) ||
+        (mem = mmap(0, sizeof(Broadcast::layout), PROT_READ, MAP_SHARED, 
+                    fd, 0)) == MAP_FAILED) {
+        close(fd);
+        throw "The published game is of another version";
+    }
+    close(fd);
+
+    shm = static_cast<const Broadcast::layout *>(mem);
+    if (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) != 
+        Broadcast::layout_magic) {
+        munmap(const_cast<Broadcast::layout *>(shm), 
+               sizeof(Broadcast::layout));
+        throw "The published game is not ready";
+    }
+}
+
+BroadcastReader::~BroadcastReader()
+{
+    munmap(const_cast<Broadcast::layout *>(shm), sizeof(Broadcast::layout));
+}
+
+void BroadcastReader::ReadSnapshot(Broadcast::snapshot &s)
+{
+    for (;;) {
+        uint32_t lock = __atomic_load_n(&shm->snap_lock, __ATOMIC_ACQUIRE);
+
+        /* The writer is in the middle of an event, for a moment */
+        if (lock & 1) { 
+            sched_yield();
+            continue;
+        }
+
+        memcpy(&s, &shm->snap, sizeof(s));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shm->snap_lock, __ATOMIC_RELAXED) == lock) { 
+            break; 
+        }
+    }
+
+    next = s.next;
+}
+
+int BroadcastReader::Poll(Broadcast::event *events, int max)
+{
+    uint64_t head = __atomic_load_n(&shm->head, __ATOMIC_ACQUIRE);
+    int n = 0;
+
+    if (head - next > Broadcast::ring_size) { return -1; }
+
+    for (; next < head && n < max; n++, next++) {
+        const Broadcast::event &slot = 
+            shm->ring[next & (Broadcast::ring_size - 1)];
+        uint64_t seq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+
+        /* Being written or written again: a lap behind */
+        if (seq != next + 1) { return -1; }
+
+        memcpy(&events[n], &slot, sizeof(slot));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot.seq, __ATOMIC_RELAXED) != seq) { return -1; }
+    }
+
+    return n;
+}
+
+bool BroadcastReader::IsClosed() const
+{
+    return __atomic_load_n(&shm->closed, __ATOMIC_ACQUIRE) != 0;
+}
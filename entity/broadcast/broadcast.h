@@ -0,0 +1,213 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BROADCAST_H_SENTRY
+#define BROADCAST_H_SENTRY
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../variant/variant.h"
+#include "../player/player.h"
+
+/**
+ * @class Broadcast
+ * @brief Publisher of a live game in POSIX shared memory ("--publish").
+ * 
+ * The game is sent as a stream of small events through a ring of
+ * ring_size slots with one writer and any number of readers (see
+ * BroadcastReader), which map it read-only: the writer never waits for
+ * them. Each slot carries the sequence number of its event, stored
+ * after the event, so a reader that has fallen more than a ring behind
+ * finds a newer number, or a changed one after the copy, and resyncs
+ * from the snapshot: the state the events have built so far, kept under
+ * a sequence lock.
+ */
+class Broadcast {
+public:
+    /**
+     * @enum event_type
+     * 
+     * @var reset A new game: empty field and history.
+     * @var mark, unmark A mark of plr at row, col is set, cleared.
+     * @var line A line of the history is added.
+     * @var clear_lines The history is emptied, the lines are sent again.
+     * @var panel The panel (ConsoleUI::panel_version in row) of plr.
+     */
+    enum event_type { reset, mark, unmark, line, clear_lines, panel };
+
+    enum {
+        ring_size = 1024,       /**< Events in the ring, a power of 2 */
+        max_cells = 256,        /**< Largest field */
+        history_size = 10,      /**< Lines kept, as by ConsoleUI */
+        text_size = 16,         /**< Text of a line with the NUL */
+        name_size = 32,         /**< Title, label and nicknames */
+        no_player = 2           /**< plr of an event about no one */
+    };
+
+    /**
+     * @struct event
+     * @brief A change of the shown game, 32 bytes.
+     * 
+     * plr is the index of the player in SetPlayers or no_player.
+     */
+    struct event {
+        uint64_t seq;           /**< Sequence number + 1, 0 while written */
+        uint8_t type;           /**< event_type */
+        uint8_t plr;
+        int16_t row, col;
+        int16_t move_count;     /**< Of a line */
+        char text[text_size];   /**< Of a line */
+    };
+
+    /**
+     * @struct snapshot
+     * @brief The state of the game after the events before next.
+     */
+    struct snapshot {
+        uint64_t next;                  /**< First event not in it */
+        uint8_t marks[max_cells];       /**< plr + 1 by cell, 0 if empty */
+        int16_t last_row, last_col;     /**< Last mark, -1 if none */
+        uint8_t panel, panel_plr;
+        int16_t line_count;
+        event lines[history_size];      /**< Oldest first */
+    };
+
+    /**
+     * @struct layout
+     * @brief The shared memory object.
+     * 
+     * magic is stored last: a reader that sees it sees the rest.
+     */
+    struct layout {
+        uint32_t magic;
+        uint32_t closed;                /**< The game has ended */
+        int32_t pid;                    /**< Of the publisher */
+        int32_t rows, cols, block_rows, block_cols;
+        char title[name_size];
+        char block_label[name_size];    /**< Empty if none */
+        char names[2][name_size];
+        char marks[2];
+        uint64_t head;                  /**< Events published */
+        uint32_t snap_lock;             /**< Odd while snap is written */
+        snapshot snap;
+        event ring[ring_size];
+    };
+
+    enum { layout_magic = 0x54545462 };
+
+private:
+    char path[name_size + 8];   /**< Name of the shared memory object */
+    layout *shm;
+
+public:
+    /**
+     * @param name The game as named to "ttt watch".
+     * @param variant Rules of the game, for the field and the title.
+     * 
+     * @throws const char * if the object can't be created, another
+     *         live game has the name or the field is larger than
+     *         max_cells.
+     */
+    Broadcast(const char *name, const Variant &variant);
+
+    /**
+     * @brief Marks the game as ended and removes the name; the readers
+     *        keep the memory they have mapped.
+     */
+    ~Broadcast();
+
+    void SetPlayers(const Player &first, const Player &second);
+
+    void Reset();
+    void Mark(int row, int col, int plr);
+    void Unmark(int row, int col);
+    void Line(int move_count, int plr, const char *text);
+    void ClearLines();
+    void Panel(int version, int plr);
+
+    /**
+     * @brief Shared memory object of the game name, "/ttt-NAME".
+     * 
+     * @throws const char * if the name is empty, too long or has a '/'.
+     */
+    static void GetPath(const char *name, char *path, size_t size);
+
+private:
+    Broadcast(Broadcast &b);
+    void operator=(Broadcast &b);
+
+    /**
+     * @brief Writes the event into the ring, then into the snapshot.
+     */
+    void Publish(event &e);
+
+    static void Apply(snapshot &s, const event &e, int cols);
+
+    /**
+     * @return true if a game under the path has ended or its publisher
+     *         is gone, false if it is live or can't be told.
+     */
+    static bool IsStale(const char *path);
+};
+
+/**
+ * @class BroadcastReader
+ * @brief Follows a game published by Broadcast.
+ * 
+ * Start with ReadSnapshot, then Poll for the events after it; when Poll
+ * reports an overrun, read the snapshot again.
+ */
+class BroadcastReader {
+private:
+    const Broadcast::layout *shm;
+    uint64_t next;              /**< Sequence number of the next event */
+
+public:
+    /**
+     * @throws const char * if no such game is published.
+     */
+    explicit BroadcastReader(const char *name);
+    ~BroadcastReader();
+
+    const Broadcast::layout &GetLayout() const { return *shm; }
+
+    /**
+     * @brief Copies a consistent snapshot, the events follow it.
+     */
+    void ReadSnapshot(Broadcast::snapshot &s);
+
+    /**
+     * @brief Copies the events published since the last call.
+     * 
+     * @return Number of events, up to max; -1 if the writer has
+     *         overwritten some of them (the copied ones are void too).
+     */
+    int Poll(Broadcast::event *events, int max);
+
+    /** @brief The game has ended, check before the last Poll */
+    bool IsClosed() const;
+
+private:
+    BroadcastReader(BroadcastReader &r);
+    void operator=(BroadcastReader &r);
+};
+
+#endif /* BROADCAST_H_SENTRY */
@@ -21,50 +21,163 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
 
 #include "console_ui.h"
-
-ConsoleUI::ConsoleUI() 
-    : default_fill('_')
+#include "../stats/stats.h"
+#include "../trace/trace.h"
+
+const char *const ConsoleUI::screen_on = "\033[?1049h";
+const char *const ConsoleUI::screen_off = "\033[?1049l";
+
+volatile sig_atomic_t ConsoleUI::resized = 0;
+
+ConsoleUI::ConsoleUI(int rows, int cols, const char *title, 
+                     int block_rows, int block_cols) 
+    : rows(rows)
+    , cols(cols)
+    , block_rows(block_rows)
+    , block_cols(block_cols)
+    , block_label(0)
+    , default_fill('_')
+    , view_row(0)
+    , last_row(-1)
+    , last_col(-1)
     , output_lines(0)
-    , panel_lines(13)
-    , field_lines(5)
+    , panel_lines(panel_rows)
     , separator_lines(2)
+    , page_rows(view_rows)
+    , screen(false)
+    , layout(stacked)
+    , win_rows(0)
+    , win_cols(0)
+    , history_rows(gameplay_size)
+    , shown(0)
+    , last_panel(info)
+    , last_player(0)
+    , printed(false)
+    , out(&OutputSink::Stdout())
 {
+    memset(&frame, 0, sizeof(frame));
+    memset(&emit, 0, sizeof(emit));
+    field = new char[rows * cols];
+    overlay = new char[rows * cols];
+    overlay_on = false;
+    NickAlignment(this->title, title, strlen(title));
+    NickAlignment(move_format, "row column", strlen("row column"));
+    BuildPanels();
     memset(gameplay, 0, sizeof(gameplay));
+    memset(clock_line, 0, sizeof(clock_line));
     ClearField();
 }
 
 ConsoleUI::~ConsoleUI()
 {
+    LeaveScreen(false);
+    free(frame.data);
+    free(emit.data);
     DeleteAllMove();
+    delete[] field;
+    delete[] overlay;
+}
+
+bool ConsoleUI::Scroll(int pages)
+{
+    int old = view_row;
+
+    if (!IsPaged()) { return false; }
+
+    view_row += pages * (page_rows / 2);
+    if (view_row > rows - page_rows) { view_row = rows - page_rows; }
+    if (view_row < 0) { view_row = 0; }
+
+    return view_row != old;
+}
+
+void ConsoleUI::Focus(int rowi)
+{
+    if (!IsPaged()) { return; }
+
+    if (rowi < view_row) { view_row = rowi; }
+    if (rowi >= view_row + page_rows) { view_row = rowi - page_rows + 1; }
 }
 
 void ConsoleUI::Print(panel_version v, const Player *p)
 {
+    StatTimer timer(Stats::render);
+    TraceSpan span("ConsoleUI::Print");
+
+    last_panel = v;
+    last_player = p;
+    printed = true;
+
+    frame.len = 0;
     PrintPanel(v, p);
     PrintSeparator();
     PrintField();
     PrintGameplay();
+
+    if (screen) { Compose(); }
+    else { out->Write(frame.data, frame.len); }
+    out->Flush();
+}
+
+int ConsoleUI::RenderField(const char **lines, int max)
+{
+    StatTimer timer(Stats::render);
+    int saved = output_lines;
+    int n = 0;
+    char *line;
+
+    frame.len = 0;
+    PrintField();
+    output_lines = saved;
+
+    /* Every line follows a '\n' and starts with the '\t' of the indent */
+    for (line = frame.data; n < max && (line = strchr(line, '\n')); ) {
+        *line++ = '\0';
+        if (*line == '\t') { line++; }
+        lines[n++] = line;
+    }
+
+    return n;
 }
 
 void ConsoleUI::Clear()
 {
+    StatTimer timer(Stats::clear);
+    TraceSpan span("ConsoleUI::Clear");
+
+    /* The next frame overwrites what changed */
+    if (screen) { 
+        output_lines = 0;
+        return; 
+    }
+
+    emit.len = 0;
     for (int i = 0; i < output_lines; i++) {
-        fputs("\033[2K", stdout);
-        if (i < output_lines - 1) { fputs("\033[1A", stdout); }
+        Emit("\033[2K");
+        if (i < output_lines - 1) { Emit("\033[1A"); }
     }
 
     output_lines = 0;
 
-    fputc('\r', stdout);
-    fflush(stdout);
+    Emit("\r");
+    out->Write(emit.data, emit.len);
+    out->Flush();
 }
 
 bool ConsoleUI::AddMove(const char *str, size_t len)
 {
     if (!str || len <= 0) { return false; }
 
+    /* Full: the oldest move makes room */
+    if (gameplay[gameplay_size - 1]) {
+        free(gameplay[0]);
+        memmove(gameplay, gameplay + 1, (gameplay_size - 1) * sizeof(char *));
+        gameplay[gameplay_size - 1] = static_cast<char *>(0);
+    }
+
     for (int i = 0; i < gameplay_size; i++) {
         if (gameplay[i] != 0) { continue; }
 
@@ -98,15 +211,24 @@ void ConsoleUI::DeleteAllMove()
     }
 }
 
+int ConsoleUI::GetMoveCount() const
+{
+    int count = 0;
+
+    while (count < gameplay_size && gameplay[count]) { count++; }
+
+    return count;
+}
+
 bool ConsoleUI::IsBusy(int rowi, int coli, char &mark) const
 {
-    if ((rowi > row_count - 1 || rowi < 0 ) ||
-        (coli > col_count - 1 || coli < 0 )) { 
+    if ((rowi > rows - 1 || rowi < 0 ) ||
+        (coli > cols - 1 || coli < 0 )) { 
         mark = '\0';
         return true;
     }
 
-    mark = field[rowi][coli];
+    mark = field[rowi * cols + coli];
     if (mark == default_fill) { return false; }
 
     return true;
@@ -114,34 +236,205 @@ bool ConsoleUI::IsBusy(int rowi, int coli, char &mark) const
 
 bool ConsoleUI::SetMark(int rowi, int coli, const Player &p)
 {
-    if (rowi > row_count - 1 || rowi < 0 ) { return false; }
-    if (coli > col_count - 1 || coli < 0 ) { return false; }
-
-    field[rowi][coli] = p.GetMark();
+    if (rowi > rows - 1 || rowi < 0 ) { return false; }
+    if (coli > cols - 1 || coli < 0 ) { return false; }
+
+    field[rowi * cols + coli] = p.GetMark();
+    ClearOverlay();
+    last_row = rowi;
+    last_col = coli;
+    Focus(rowi);
     return true;
 }
 
 bool ConsoleUI::ClearMark(int rowi, int coli)
 {
-    if (rowi > row_count - 1 || rowi < 0 ) { return false; }
-    if (coli > col_count - 1 || coli < 0 ) { return false; }
+    if (rowi > rows - 1 || rowi < 0 ) { return false; }
+    if (coli > cols - 1 || coli < 0 ) { return false; }
 
-    field[rowi][coli] = default_fill;
+    field[rowi * cols + coli] = default_fill;
+    ClearOverlay();
+    if (rowi == last_row && coli == last_col) { last_row = last_col = -1; }
     return true;
 }
 
 void ConsoleUI::ClearField()
 {
-    for (int i = 0; i < row_count; i++) {
-        for (int j = 0; j < col_count; j++) {
-            field[i][j] = default_fill;
+    for (int i = 0; i < rows * cols; i++) { field[i] = default_fill; }
+    ClearOverlay();
+
+    view_row = 0;
+    last_row = last_col = -1;
+}
+
+bool ConsoleUI::SetOverlay(int rowi, int coli, char hint)
+{
+    if (rowi > rows - 1 || rowi < 0 ) { return false; }
+    if (coli > cols - 1 || coli < 0 ) { return false; }
+
+    overlay[rowi * cols + coli] = hint;
+    overlay_on = true;
+    return true;
+}
+
+void ConsoleUI::ClearOverlay()
+{
+    memset(overlay, 0, rows * cols);
+    overlay_on = false;
+}
+
+void ConsoleUI::SetClock(const char *text)
+{
+    NickAlignment(clock_line, text, strlen(text));
+}
+
+void ConsoleUI::RefreshClock()
+{
+    StatTimer timer(Stats::render);
+
+    if (screen) {
+        /* The panel is at the top left */
+        out->Print("\0337\033[%d;1H| %-27s |\0338", clock_row + 1, clock_line);
+        if (shown) { 
+            free(shown[clock_row]);
+            shown[clock_row] = 0;
+        }
+        out->Flush();
+        return;
+    }
+
+    /* The cursor is on the last output line, the panel is on top */
+    if (output_lines < panel_lines) { return; }
+
+    out->Print("\0337\033[%dA\r| %-27s |\0338", output_lines - 1 - clock_row, 
+           clock_line);
+    out->Flush();
+}
+
+/*
+ * Lines of the panels; a line of one char is a slot: 'T' the title,
+ * 'F' the move format, 'N' the nickname, 'C' the clock, 'S' the scroll
+ * hint and 'M' the message of the panel (panel_message).
+ */
+static const char *const info_art[] = {
+    " _____________________________",
+    "T",
+    "|         INFORMATION         |",
+    "| To move, enter the numbers: |",
+    "F",
+    "|                             |",
+    "|   The first move is for:    |",
+    "|                             |",
+    "N",
+    "|                             |",
+    "|                             |",
+    "|                             |",
+    "|       Enjoy the game!       |",
+    "|_____________________________|"
+};
+
+static const char *const game_art[] = {
+    " _____________________________",
+    "T",
+    "|          GAME TIME          |",
+    "|   Player's expected move:   |",
+    "|                             |",
+    "N",
+    "C",
+    "| Commands:                   |",
+    "| - quit (to exit)            |",
+    "| - rest (to restart)         |",
+    "| - undo, redo, hint          |",
+    "S",
+    "M",
+    "|_____________________________|"
+};
+
+static const char *const over_art[] = {
+    " _____________________________",
+    "T",
+    "|          GAME OVER          |",
+    "|        The winner is        |",
+    "|                             |",
+    "N",
+    "C",
+    "| Commands:                   |",
+    "| - quit (to exit)            |",
+    "| - rest (to restart)         |",
+    "|                             |",
+    "|                             |",
+    "|       Come back again!      |",
+    "|_____________________________|"
+};
+
+/* By ConsoleUI::panel_version */
+static const char *const panel_message[] = {
+    "",
+    "",
+    " Invalid input. Try again!",
+    " Cell is busy.  Try again!",
+    " Out of range.  Try again!",
+    " Not allowed.  Try again!",
+    ""
+};
+
+void ConsoleUI::SetMoveFormat(const char *format)
+{
+    NickAlignment(move_format, format, strlen(format));
+    BuildPanels();
+}
+
+void ConsoleUI::BuildPanels()
+{
+    for (int v = 0; v < panel_count; v++) {
+        panel_template &t = panels[v];
+        const char *const *art = v == info ? info_art 
+                               : v == game_over ? over_art : game_art;
+        char *line = t.text;
+
+        t.nickname = t.clock = t.scroll = -1;
+
+        for (int r = 0; r < panel_rows; r++) {
+            int len = strlen(art[r]);
+
+            if (len > 1) { memcpy(line, art[r], len); }
+            else {
+                len = panel_cols;
+                memcpy(line, "| ", 2);
+                FillSlot(line + 2, "");
+                memcpy(line + 2 + slot_cols, " |", 2);
+            }
+
+            switch (art[r][0]) {
+                case 'T': FillSlot(line + 2, title); break;
+                case 'F': FillSlot(line + 2, move_format); break;
+                case 'N': t.nickname = line + 2 - t.text; break;
+                case 'C': t.clock = line + 2 - t.text; break;
+                case 'S': t.scroll = line + 2 - t.text; break;
+                case 'M': FillSlot(line + 2, panel_message[v]); break;
+            }
+
+            line += len;
+            if (r < panel_rows - 1) { *line++ = '\n'; }
         }
+        t.len = line - t.text;
     }
 }
 
+void ConsoleUI::FillSlot(char *slot, const char *text)
+{
+    int i;
+
+    for (i = 0; i < slot_cols && text[i]; i++) { slot[i] = text[i]; }
+    for (; i < slot_cols; i++) { slot[i] = ' '; }
+}
+
 void ConsoleUI::PrintPanel(panel_version v, const Player *p)
 {
+    const panel_template &t = panels[v];
     char nickname[28];
+    char *text;
+
     memset(nickname, 0, sizeof(nickname));
 
     if (p) {
@@ -151,144 +444,399 @@ void ConsoleUI::PrintPanel(panel_version v, const Player *p)
         strncpy(nickname, "  No one, just no one ...", sizeof(nickname) - 1);
     }
 
-    switch (v) {
-        case info:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|         INFORMATION         |\n");
-            printf("| To move, enter the row and  |\n");
-            printf("| column separated by a space.|\n");
-            printf("|                             |\n");
-            printf("|   The first move is for:    |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("|                             |\n");
-            printf("|       Enjoy the game!       |\n");
-            printf("|_____________________________|");
-            break;
-
-        case game_time:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|          GAME TIME          |\n");
-            printf("|   Player's expected move:   |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("| Commands:                   |\n");
-            printf("| - quit (to exit)            |\n");
-            printf("| - rest (to restart)         |\n");
-            printf("|                             |\n");
-            printf("|                             |\n");
-            printf("|_____________________________|");
-            break;
-        
-        case input_error:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|          GAME TIME          |\n");
-            printf("|   Player's expected move:   |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("| Commands:                   |\n");
-            printf("| - quit (to exit)            |\n");
-            printf("| - rest (to restart)         |\n");
-            printf("|                             |\n");
-            printf("|  Invalid input. Try again!  |\n");
-            printf("|_____________________________|");
-            break;
-
-        case busy_error:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|          GAME TIME          |\n");
-            printf("|   Player's expected move:   |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("| Commands:                   |\n");
-            printf("| - quit (to exit)            |\n");
-            printf("| - rest (to restart)         |\n");
-            printf("|                             |\n");
-            printf("|  Cell is busy.  Try again!  |\n");
-            printf("|_____________________________|");
-            break;
-
-        case range_error:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|          GAME TIME          |\n");
-            printf("|   Player's expected move:   |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("| Commands:                   |\n");
-            printf("| - quit (to exit)            |\n");
-            printf("| - rest (to restart)         |\n");
-            printf("|                             |\n");
-            printf("|  Out of range.  Try again!  |\n");
-            printf("|_____________________________|");
-            break;
-
-        case game_over:
-            printf(" _____________________________\n");
-            printf("|         Tic Tac Toe         |\n");
-            printf("|          GAME OVER          |\n");
-            printf("|        The winner is        |\n");
-            printf("|                             |\n");
-            printf("| %-27s |\n"                      , nickname);
-            printf("|                             |\n");
-            printf("| Commands:                   |\n");
-            printf("| - quit (to exit)            |\n");
-            printf("| - rest (to restart)         |\n");
-            printf("|                             |\n");
-            printf("|       Come back again!      |\n");
-            printf("|_____________________________|");
-            break;
+    Append(frame, t.text, t.len);
+    text = frame.data + frame.len - t.len;
+
+    FillSlot(text + t.nickname, nickname);
+    if (t.clock >= 0) { FillSlot(text + t.clock, clock_line); }
+    if (t.scroll >= 0 && IsPaged()) { 
+        FillSlot(text + t.scroll, "- up, down (to scroll)"); 
     }
 
     output_lines += panel_lines;
-    fflush(stdout);
 }
 
 void ConsoleUI::PrintSeparator()
 {
-    printf("\n\n[=============================]");
+    Out("\n\n[=============================]");
 
-    fflush(stdout);
     output_lines += separator_lines;
 }
 
 void ConsoleUI::PrintField()
 {
-	printf("\n\t    0   1   2\n");
-	printf("\t   ___ ___ ___\n");
-	printf("\t0 |_%c_|_%c_|_%c_|\n", field[0][0], field[0][1], field[0][2]);
-	printf("\t1 |_%c_|_%c_|_%c_|\n", field[1][0], field[1][1], field[1][2]);
-	printf("\t2 |_%c_|_%c_|_%c_|", field[2][0], field[2][1], field[2][2]);
+    if (!IsClassic()) { 
+        PrintGrid();
+        PrintLegend();
+        return;
+    }
+
+    char c[row_count * col_count];
+    for (int i = 0; i < row_count * col_count; i++) { 
+        c[i] = GetCellChar(i, default_fill); 
+    }
+
+	Out("\n\t    0   1   2\n");
+	Out("\t   ___ ___ ___\n");
+	Out("\t0 |_%c_|_%c_|_%c_|\n", c[0], c[1], c[2]);
+	Out("\t1 |_%c_|_%c_|_%c_|\n", c[3], c[4], c[5]);
+	Out("\t2 |_%c_|_%c_|_%c_|", c[6], c[7], c[8]);
+
+    output_lines += 5;
+    PrintLegend();
+}
+
+void ConsoleUI::PrintLegend()
+{
+    if (overlay_on) {
+        Out("\n\thint: w d l proven, + = - estimated");
+        output_lines++;
+    }
+}
+
+char ConsoleUI::GetCellChar(int index, char empty) const
+{
+    if (field[index] != default_fill) { return field[index]; }
+    if (overlay[index]) { return overlay[index]; }
+
+    return empty;
+}
+
+void ConsoleUI::PrintGrid()
+{
+    int end = IsPaged() ? view_row + page_rows : rows;
+
+    if (block_label && block_cols) {
+        Out("\n\t   ");
+        for (int b = 0; b < cols / block_cols; b++) {
+            int width = block_cols * 3 - 3 - strlen(block_label);
+            Out("%s  %s %-*d", b ? " " : "", block_label, width, b);
+        }
+        output_lines++;
+    }
+
+    Out("\n\t   ");
+    for (int j = 0; j < cols; j++) { 
+        if (block_cols && j && j % block_cols == 0) { Out(" "); }
+        Out("%2d ", block_label && block_cols ? j % block_cols : j); 
+    }
+    output_lines++;
+
+    for (int i = view_row; i < end; i++) {
+        if (block_rows && i && i % block_rows == 0) { PrintBlockLine(); }
+        PrintGridRow(i);
+    }
+
+    if (IsPaged()) {
+        Out("\n\t   rows %d-%d of %d", view_row, end - 1, rows);
+        output_lines++;
+    }
+}
+
+void ConsoleUI::PrintGridRow(int rowi)
+{
+    Out("\n\t%2d ", rowi);
+    for (int j = 0; j < cols; j++) {
+        char mark = GetCellChar(rowi * cols + j, '.');
+        bool last = rowi == last_row && j == last_col;
+
+        if (block_cols && j && j % block_cols == 0) { Out("|"); }
+        Out("%c%c%c", last ? '[' : ' ', mark, last ? ']' : ' ');
+    }
+    output_lines++;
+}
 
-    fflush(stdout);
-    output_lines += field_lines;
+void ConsoleUI::PrintBlockLine()
+{
+    Out("\n\t   ");
+    for (int j = 0; j < cols; j++) {
+        if (block_cols && j && j % block_cols == 0) { Out("+"); }
+        Out("---");
+    }
+    output_lines++;
 }
 
 void ConsoleUI::PrintGameplay()
 {
-    putc('\n', stdout);
+    Out("\n");
     output_lines++;
 
-    putc('\n', stdout);
+    Out("\n");
     output_lines++;
 
-    for (int i = 0; i < gameplay_size; i++) {
+    /* The screen may have room for the latest ones only */
+    int first = screen ? GetMoveCount() - history_rows : 0;
+
+    for (int i = first > 0 ? first : 0; i < gameplay_size; i++) {
         if (gameplay[i]) {
-            printf("%s\n", gameplay[i]);
+            Out("%s\n", gameplay[i]);
             output_lines++;
         }
     }
-    
-    fflush(stdout);
+}
+
+bool ConsoleUI::EnterScreen()
+{
+    struct sigaction sa;
+
+    if (screen) { return true; }
+    if (!out->GetWindow(win_rows, win_cols)) { return false; }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = OnResize;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &sa, &saved_winch);
+
+    screen = true;
+    resized = 1;
+
+    out->Puts(screen_on);
+    out->Flush();
+    return true;
+}
+
+void ConsoleUI::LeaveScreen(bool keep)
+{
+    if (!screen) { return; }
+
+    sigaction(SIGWINCH, &saved_winch, 0);
+
+    for (int i = 0; shown && i < win_rows; i++) { free(shown[i]); }
+    free(shown);
+    shown = 0;
+
+    screen = false;
+    page_rows = view_rows;
+    history_rows = gameplay_size;
+    if (view_row > rows - page_rows) { view_row = rows > page_rows ? rows - page_rows : 0; }
+    if (last_row != -1) { Focus(last_row); }
+
+    out->Puts(screen_off);
+    out->Flush();
+
+    output_lines = 0;
+    if (keep && printed) { 
+        Print(last_panel, last_player); 
+        out->Putc('\n');
+        out->Flush();
+    }
+}
+
+void ConsoleUI::Out(const char *fmt, ...)
+{
+    char line[256];
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+
+    if (len > 0) { 
+        Append(frame, line, static_cast<size_t>(len) < sizeof(line) ? len 
+                                                    : sizeof(line) - 1); 
+    }
+}
+
+void ConsoleUI::Emit(const char *fmt, ...)
+{
+    char line[256];
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+
+    if (len > 0) { 
+        Append(emit, line, static_cast<size_t>(len) < sizeof(line) ? len 
+                                                   : sizeof(line) - 1); 
+    }
+}
+
+void ConsoleUI::Append(buffer &b, const char *str, size_t len)
+{
+    if (b.len + len + 1 > b.cap) {
+        size_t cap = b.cap ? b.cap : 1024;
+
+        while (cap < b.len + len + 1) { cap *= 2; }
+        b.data = static_cast<char *>(realloc(b.data, cap));
+        b.cap = cap;
+    }
+
+    memcpy(b.data + b.len, str, len);
+    b.len += len;
+    b.data[b.len] = '\0';
+}
+
+void ConsoleUI::Compose()
+{
+    TraceSpan span("ConsoleUI::Compose");
+    enum { max_lines = 256 };
+    const char *lines[max_lines];
+    int count = 0, body, body_lines, prompt_row;
+    buffer row;
+
+    emit.len = 0;
+    if (resized || !shown) { Layout(); }
+
+    /* Lines of the frame, the last one is the prompt */
+    lines[count++] = frame.data;
+    for (char *c = frame.data; *c && count < max_lines; c++) {
+        if (*c == '\n') {
+            *c = '\0';
+            lines[count++] = c + 1;
+        }
+    }
+    count--;
+
+    /* Side by side the field goes up, without the blank line above */
+    body = layout == side_by_side ? panel_lines + 1 : panel_lines;
+    body_lines = count - body;
+    prompt_row = layout == side_by_side ? 
+                     (body_lines > panel_lines ? body_lines : panel_lines) : count;
+    if (prompt_row > win_rows - 2) { prompt_row = win_rows - 2; }
+    if (prompt_row < 0) { prompt_row = 0; }
+
+    memset(&row, 0, sizeof(row));
+
+    for (int r = 0; r < win_rows; r++) {
+        row.len = 0;
+        Append(row, "", 0);
+
+        if (r < prompt_row) {
+            if (layout == stacked) { AppendExpanded(row, lines[r], 0); }
+            else {
+                int col = r < panel_lines ? AppendExpanded(row, lines[r], 0) : 0;
+
+                if (r < body_lines && *lines[body + r]) {
+                    for (; col < panel_cols + gap_cols; col++) { Append(row, " ", 1); }
+                    AppendExpanded(row, lines[body + r], col);
+                }
+            }
+        }
+
+        /* Unchanged, or blank on both */
+        if (shown[r] ? strcmp(shown[r], row.data) == 0 : row.len == 0) { continue; }
+        if (r == prompt_row) { continue; }
+
+        Emit("\033[%d;1H", r + 1);
+        Append(emit, row.data, row.len);
+        Emit("\033[K");
+
+        free(shown[r]);
+        shown[r] = row.len ? strdup(row.data) : 0;
+    }
+
+    /* The input line starts empty */
+    Emit("\033[%d;1H\033[K", prompt_row + 1);
+    free(shown[prompt_row]);
+    shown[prompt_row] = 0;
+
+    out->Write(emit.data, emit.len);
+    free(row.data);
+}
+
+void ConsoleUI::Layout()
+{
+    TraceSpan span("ConsoleUI::Layout");
+    bool pageable = !IsClassic() && !block_rows;
+    int least = pageable && rows > 4 ? 4 : rows;
+    bool found = false;
+
+    resized = 0;
+
+    for (int i = 0; shown && i < win_rows; i++) { free(shown[i]); }
+    free(shown);
+
+    if (!out->GetWindow(win_rows, win_cols)) {
+        win_rows = 24;
+        win_cols = 80;
+    }
+    shown = static_cast<char **>(calloc(win_rows, sizeof(char *)));
+
+    /* The whole field first, then the history, then the panel above it */
+    for (int page = rows; !found && page >= least; page--) {
+        for (int history = gameplay_size; !found && history >= 3; history--) {
+            for (int m = stacked; !found && m <= side_by_side; m++) {
+                if (Fits(static_cast<layout_mode>(m), page, history)) {
+                    layout = static_cast<layout_mode>(m);
+                    page_rows = page;
+                    history_rows = history;
+                    found = true;
+                }
+            }
+        }
+    }
+
+    /* Too small: the bottom rows are cut */
+    if (!found) {
+        layout = win_cols >= panel_cols + gap_cols + 43 ? side_by_side : stacked;
+        page_rows = pageable && rows > view_rows ? view_rows : rows;
+        history_rows = 1;
+    }
+
+    if (view_row > rows - page_rows) { view_row = rows > page_rows ? rows - page_rows : 0; }
+    if (last_row != -1) { Focus(last_row); }
+
+    Emit("\033[2J");
+}
+
+bool ConsoleUI::Fits(layout_mode mode, int page, int history) const
+{
+    /* Blank line and separator, field, hint legend, blank line, moves */
+    int body = separator_lines + GetFieldLines(page) + 1 + 1 + history;
+    int width = IsClassic() ? 0 : 11 + 3 * cols + (block_cols ? cols / block_cols - 1 : 0);
+
+    /* The hint legend is the widest line of a small field */
+    if (width < 43) { width = 43; }
+
+    /* And the input line with a spare one under it */
+    if (mode == stacked) { return panel_lines + body + 2 <= win_rows && width <= win_cols; }
+
+    body--;
+    return (body > panel_lines ? body : panel_lines) + 2 <= win_rows && 
+           panel_cols + gap_cols + width <= win_cols;
+}
+
+int ConsoleUI::GetFieldLines(int page) const
+{
+    if (IsClassic()) { return 5; }
+
+    return (block_label && block_cols ? 1 : 0) + 1 + page + 
+           (block_rows ? (page - 1) / block_rows : 0) + (page < rows ? 1 : 0);
+}
+
+int ConsoleUI::AppendExpanded(buffer &b, const char *line, int col)
+{
+    for (const char *c = line; *c; c++) {
+        if (*c == '\t') {
+            do { 
+                Append(b, " ", 1); 
+            } while (++col % 8);
+        }
+        else if (*c == '\033') {
+            /* Colors: "\033[...m" takes no column */
+            const char *end = c + 1;
+            while (*end && !(*end >= '@' && *end <= '~' && end > c + 1)) { end++; }
+            if (!*end) { break; }
+            Append(b, c, end - c + 1);
+            c = end;
+        }
+        else {
+            Append(b, c, 1);
+            col++;
+        }
+    }
+
+    return col;
+}
+
+void ConsoleUI::OnResize(int sig)
+{
+    (void)sig;
+    resized = 1;
 }
 
 void ConsoleUI::NickAlignment(char (&dest)[28], 
@@ -21,20 +21,43 @@
 #ifndef CONSOLE_UI_H_SENTRY
 #define CONSOLE_UI_H_SENTRY
 
+#include <stddef.h>
+#include <signal.h>
+
 #include "../player/player.h"
+#include "../output_sink/output_sink.h"
 
 /**
  * @class ConsoleUI
  * @brief Rendering of info panels, playing field, and player moves.
+ * 
+ * The 3x3 field is drawn as a table. Larger fields are drawn as a grid,
+ * and if they have more than ConsoleUI::view_rows rows only a page of
+ * them is shown: the page follows the last mark and can be scrolled.
+ * A grid split into blocks (e.g. the boards of ultimate tic-tac-toe)
+ * is drawn whole with lines between the blocks.
+ * 
+ * Each Print composes a frame of text first. It is written as is, the
+ * lines after the previous frame, or, on the alternate screen (see
+ * ConsoleUI::EnterScreen), laid out at absolute positions: only the
+ * rows that differ from the screen are written, in one write. The
+ * layout fits the window and is recomputed only after SIGWINCH.
  */
 class ConsoleUI {
 public:
     /**
      * @enum field_size
-     * @brief The size of the playing field.
+     * @brief The size of the classic playing field.
      */
     enum field_size { row_count = 3, col_count = 3 };
 
+    /** Rows of a page of a large field, unless the screen has room */
+    enum { view_rows = 8 };
+
+    /** Sequences that enter and leave the alternate screen */
+    static const char *const screen_on;
+    static const char *const screen_off;
+
     /**
      * @enum panel_version
      * 
@@ -45,6 +68,7 @@ public:
      * @var input_error Game panel with input error message.
      * @var busy_error Game panel with busy cell message.
      * @var range_error Game panel with out of range message.
+     * @var rule_error Game panel with a move the rules forbid.
      * @var game_over Final panel showing winner.
      * 
      * @see ConsoleUI::Print
@@ -52,26 +76,169 @@ public:
     enum panel_version { 
         info, 
         game_time, 
-        input_error, busy_error, range_error, 
+        input_error, busy_error, range_error, rule_error,
         game_over 
     };
 
 private:
-    char field[row_count][col_count];   /**< Playing field          */
+    const int rows;                     /**< Size of the field      */
+    const int cols;
+    const int block_rows;               /**< Sub-grids, 0 if none   */
+    const int block_cols;
+    const char *block_label;            /**< See SetBlockLabel      */
+    char *field;                        /**< Playing field by rows  */
+    char *overlay;                      /**< Hints by rows, 0 if none */
+    bool overlay_on;                    /**< Any hint is set        */
     const char default_fill;            /**< Default cell content   */
+    char title[28];                     /**< Centered panel title   */
+    char move_format[28];               /**< See SetMoveFormat      */
+    char clock_line[28];                /**< See SetClock           */
 
+    int view_row;                       /**< First row on the page  */
+    int last_row, last_col;             /**< Last mark, -1 if none  */
+
+    /** Last moves, the oldest is dropped when it's full */
     enum { gameplay_size = 10 };
     char *gameplay[gameplay_size];      /**< Description of each move */
 
     int output_lines;                   /**< Lines printed to stdout*/
+
+    /** Lines of a panel */
+    enum { panel_rows = 14 };
     const int panel_lines;              /**< Lines in info panel    */
-    const int field_lines;              /**< Lines in playing field */
     const int separator_lines;          /**< Lines in separator     */
 
+    /** Line of the clock in the panel */
+    enum { clock_row = 6 };
+
+    /**
+     * @struct buffer
+     * @brief Growable text, see ConsoleUI::Append.
+     */
+    struct buffer {
+        char *data;
+        size_t len, cap;
+    };
+
+    buffer frame;                       /**< Text of the frame      */
+    buffer emit;                        /**< Bytes for the screen   */
+    int page_rows;                      /**< See IsPaged            */
+
+    /**
+     * @enum layout_mode
+     * @brief Where the field goes on the screen.
+     * 
+     * @var stacked Under the panel, as the lines are printed.
+     * @var side_by_side Right of the panel.
+     */
+    enum layout_mode { stacked, side_by_side };
+
+    /** Columns of the panel and the gap after it */
+    enum { panel_cols = 31, gap_cols = 2 };
+
+    /** 
+     * Most a panel text can take; a slot is the text between "| " and
+     * " |" of a line
+     */
+    enum { 
+        panel_count = game_over + 1,
+        panel_size = panel_rows * (panel_cols + 1),
+        slot_cols = panel_cols - 4
+    };
+
+    /**
+     * @struct panel_template
+     * @brief A panel built once (see BuildPanels): a frame copies the
+     *        text and fills the slots.
+     */
+    struct panel_template {
+        char text[panel_size];          /**< Last line without '\n' */
+        int len;
+        int nickname, clock, scroll;    /**< Slot offsets, -1 if none */
+    };
+
+    panel_template panels[panel_count];
+
+    bool screen;                        /**< On the alternate screen */
+    layout_mode layout;
+    int win_rows, win_cols;             /**< Size of the window     */
+    int history_rows;                   /**< Moves shown on screen  */
+    char **shown;                       /**< Rows on the screen, by
+                                             index, NULL if unknown */
+    struct sigaction saved_winch;       /**< Handler before the screen */
+
+    /** The last Print, repeated by LeaveScreen */
+    panel_version last_panel;
+    const Player *last_player;
+    bool printed;
+
+    OutputSink *out;                    /**< Where the frames go    */
+
+    /** Set by SIGWINCH, the layout is recomputed on the next frame */
+    static volatile sig_atomic_t resized;
+
 public:
-    ConsoleUI();
+    /**
+     * @param rows, cols Size of the field.
+     * @param title Name of the game in the panel.
+     * @param block_rows, block_cols Size of the sub-grids, 0 if none.
+     */
+    ConsoleUI(int rows = row_count, int cols = col_count, 
+              const char *title = "Tic Tac Toe", 
+              int block_rows = 0, int block_cols = 0);
     ~ConsoleUI();
 
+    /**
+     * @brief Moves the page of a large field.
+     * 
+     * @param pages Half pages down (positive) or up (negative).
+     * @return false if the page hasn't moved.
+     */
+    bool Scroll(int pages);
+
+    /**
+     * @brief Names the blocks of columns, e.g. "layer" (NULL: none).
+     * 
+     * The blocks get a caption with their number, and the columns are
+     * numbered inside their block. The string isn't copied.
+     */
+    void SetBlockLabel(const char *label) { block_label = label; }
+
+    /**
+     * @brief Tells the player how to enter a move, "row column" by default.
+     */
+    void SetMoveFormat(const char *format);
+
+    /**
+     * @brief Sends the output to the sink, OutputSink::Stdout by default.
+     * 
+     * The sink isn't deleted by ConsoleUI.
+     */
+    void SetSink(OutputSink *sink) { out = sink; }
+
+    /** @return true if the field doesn't fit on one page */
+    bool IsPaged() const 
+        { return rows > page_rows && !IsClassic() && !block_rows; }
+
+    /**
+     * @brief Renders on the alternate screen from now on.
+     * 
+     * Also when the window is resized (SIGWINCH) the next frame is
+     * laid out again and drawn whole.
+     * 
+     * @return false if stdout isn't a terminal, the lines are printed
+     *         as before then.
+     */
+    bool EnterScreen();
+
+    /**
+     * @brief Goes back to the normal screen.
+     * 
+     * @param keep Print the last frame there as lines, e.g. the result
+     *             of the game.
+     */
+    void LeaveScreen(bool keep);
+
     /**
      * @brief Prints the complete game interface.
      * @param v Panel version to display.
@@ -94,6 +261,16 @@ public:
      */
     void Clear();
 
+    /**
+     * @brief Draws only the field, as in the frames, for a caller that
+     *        lays it out itself (see Wall); nothing is written.
+     * 
+     * @param[out] lines Start of each line without the indent,
+     *                   valid until the next Print or RenderField.
+     * @return Number of lines, up to max.
+     */
+    int RenderField(const char **lines, int max);
+
     /**
      * @brief Adds a move description to history.
      * @param str Source string (null-terminated).
@@ -114,10 +291,16 @@ public:
      */
     void DeleteAllMove();
 
+    /**
+     * @return Number of moves in history, the last one is at
+     *         the index one less.
+     */
+    int GetMoveCount() const;
+
     /**
      * @brief Checks if the cell is occupied and returns its mark.
-     * @param rowi Row index (0 to row_count-1).
-     * @param coli Column index (0 to col_count-1).
+     * @param rowi Row index (0 to rows-1).
+     * @param coli Column index (0 to cols-1).
      * @param[out] mark Reference to store the cell's mark.
      *                  If coordinates are invalid, mark = '\0'.
      * @return true If cell is occupied or coordinates are invalid.
@@ -127,8 +310,8 @@ public:
 
     /**
      * @brief Sets player's mark at specified cell.
-     * @param rowi Row index (0 to row_count-1).
-     * @param coli Column index (0 to col_count-1).
+     * @param rowi Row index (0 to rows-1).
+     * @param coli Column index (0 to cols-1).
      * @param p Player whose mark will be placed.
      * @return true If coordinates valid and mark set.
      * @return false If coordinates out of range.
@@ -137,8 +320,8 @@ public:
 
     /**
      * @brief Clears player's mark at specified cell.
-     * @param rowi Row index (0 to row_count-1).
-     * @param coli Column index (0 to col_count-1).
+     * @param rowi Row index (0 to rows-1).
+     * @param coli Column index (0 to cols-1).
      * @return true If coordinates valid and mark cleared.
      * @return false If coordinates out of range.
      */
@@ -149,10 +332,88 @@ public:
      */
     void ClearField();
 
+    /**
+     * @brief Sets the line of the clock shown in the in-game panels.
+     * @param text Up to 27 chars, centered; empty if there is no clock.
+     */
+    void SetClock(const char *text);
+
+    /**
+     * @brief Rewrites only the clock line of the panel on the screen.
+     * 
+     * The cursor and the input typed so far stay where they are.
+     */
+    void RefreshClock();
+
+    /**
+     * @brief Shows a hint in a free cell until the field changes.
+     * @param rowi Row index (0 to rows-1).
+     * @param coli Column index (0 to cols-1).
+     * @param hint One char, see Variant::Analyze.
+     * @return false If coordinates out of range.
+     */
+    bool SetOverlay(int rowi, int coli, char hint);
+
+    /**
+     * @brief Removes all hints, done by any change of the field.
+     */
+    void ClearOverlay();
+
 private:
     ConsoleUI(ConsoleUI &ui);
     void operator=(ConsoleUI &ui);
 
+    /**
+     * @brief Adds formatted text to the frame.
+     */
+    void Out(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Adds formatted text to the bytes for the screen.
+     */
+    void Emit(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Appends text, the buffer grows twice when it's full.
+     */
+    static void Append(buffer &b, const char *str, size_t len);
+
+    /**
+     * @brief Writes the frame on the screen, only the changed rows.
+     */
+    void Compose();
+
+    /**
+     * @brief Fits the panel, the field and the history into the window.
+     * 
+     * Chooses the place of the field, the rows of a page and how many
+     * moves are shown, then clears the screen for a full redraw.
+     */
+    void Layout();
+
+    /**
+     * @brief Whether the parts fit the window.
+     * 
+     * @param page Rows of the field shown.
+     * @param history Moves shown.
+     */
+    bool Fits(layout_mode mode, int page, int history) const;
+
+    /** @return Lines of the field with a page of the rows */
+    int GetFieldLines(int page) const;
+
+    /**
+     * @brief Adds the line to the row text, tabs expanded to spaces.
+     * 
+     * @param col Column of the row where the line starts.
+     * 
+     * @return Column after the line; escape sequences take none.
+     */
+    static int AppendExpanded(buffer &b, const char *line, int col);
+
+    /** @brief SIGWINCH handler */
+    static void OnResize(int sig);
+
     /**
      * @brief Prints the info panel according to specified version.
      * @param v Panel version to display.
@@ -164,11 +425,23 @@ private:
      * - game_time_error: Same as game_time but with error message
      * - game_over: Final screen with winner info
      * 
+     * The text is copied from the template of the panel, only the
+     * nickname, the clock and the scroll hint are filled in.
      * If p is NULL, displays default message.
      * Updates output line counter.
      */
     void PrintPanel(panel_version v, const Player *p = 0);
 
+    /**
+     * @brief Builds the text of each panel with the title in it.
+     */
+    void BuildPanels();
+
+    /**
+     * @brief Writes the text left aligned into a slot, padded with spaces.
+     */
+    static void FillSlot(char *slot, const char *text);
+
     /**
      * @brief Prints a separator line between panel and field.
      * 
@@ -183,6 +456,40 @@ private:
      */
     void PrintField();
 
+    /**
+     * @brief Prints a field other than 3x3 as a grid.
+     * 
+     * The last mark is shown in brackets.
+     */
+    void PrintGrid();
+
+    /**
+     * @brief Prints a grid row with bars between the blocks of columns.
+     */
+    void PrintGridRow(int rowi);
+
+    /**
+     * @brief Prints the line between two blocks of rows.
+     */
+    void PrintBlockLine();
+
+    /**
+     * @brief Prints what the hint chars mean if any is shown.
+     */
+    void PrintLegend();
+
+    /**
+     * @return Mark of the cell, else its hint, else the empty char.
+     */
+    char GetCellChar(int index, char empty) const;
+
+    bool IsClassic() const { return rows == row_count && cols == col_count; }
+
+    /**
+     * @brief Moves the page so the row is on it.
+     */
+    void Focus(int rowi);
+
     /**
      * @brief Prints the gameplay history.
      * 
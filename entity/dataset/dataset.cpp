@@ -0,0 +1,177 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "dataset.h"
+
+Dataset::Dataset(const char *dir, const Board &rules, size_t dedup_bytes)
+    : cells(rules.GetCellCount())
+    , sym(rules.GetSize())
+    , position(0)
+    , side(0)
+    , best_move(0)
+    , outcome(0)
+    , duplicates(0)
+{
+    char path[4096];
+
+    if (cells > 16) { throw "Board is too large"; }
+    if (mkdir(dir, 0755) == -1 && errno != EEXIST) { 
+        throw "Can't create the export directory"; 
+    }
+
+    /* The largest power of two that fits */
+    uint32_t slots = 1024;
+    while (slots * 2ULL * sizeof(uint32_t) <= dedup_bytes && slots < (1U << 31)) { 
+        slots *= 2; 
+    }
+    seen = new uint32_t[slots];
+    seen_mask = slots - 1;
+    memset(seen, 0, slots * sizeof(uint32_t));
+
+    try {
+        snprintf(path, sizeof(path), "%s/position.npy", dir);
+        position = new NpyWriter(path, "|u1", 1, cells);
+        snprintf(path, sizeof(path), "%s/side.npy", dir);
+        side = new NpyWriter(path, "|u1", 1, 0);
+        snprintf(path, sizeof(path), "%s/best_move.npy", dir);
+        best_move = new NpyWriter(path, "|i1", 1, 0);
+        snprintf(path, sizeof(path), "%s/outcome.npy", dir);
+        outcome = new NpyWriter(path, "|i1", 1, 0);
+    }
+    catch (const char *) {
+        delete position;
+        delete side;
+        delete best_move;
+        delete[] seen;
+        throw;
+    }
+
+    pthread_mutex_init(&lock, 0);
+}
+
+Dataset::~Dataset()
+{
+    pthread_mutex_destroy(&lock);
+
+    delete outcome;
+    delete best_move;
+    delete side;
+    delete position;
+    delete[] seen;
+}
+
+void Dataset::Add(const row *rows, int count)
+{
+    uint8_t pos_col[chunk_rows * 16];
+    uint8_t side_col[chunk_rows];
+    int8_t move_col[chunk_rows];
+    int8_t outcome_col[chunk_rows];
+    int n = 0;
+
+    pthread_mutex_lock(&lock);
+
+    for (int i = 0; i < count; i++) {
+        const row &r = rows[i];
+
+        if (!Insert(Canonical(r.own, r.opp))) {
+            duplicates++;
+            continue;
+        }
+
+        uint16_t m0 = r.side ? r.opp : r.own;
+        uint16_t m1 = r.side ? r.own : r.opp;
+        uint8_t *pos = pos_col + n * cells;
+
+        for (int c = 0; c < cells; c++) {
+            pos[c] = (m0 >> c & 1) | (m1 >> c & 1) << 1;
+        }
+        side_col[n] = r.side;
+        move_col[n] = r.move;
+        outcome_col[n] = r.outcome;
+
+        if (++n == chunk_rows) {
+            position->Append(pos_col, n);
+            side->Append(side_col, n);
+            best_move->Append(move_col, n);
+            outcome->Append(outcome_col, n);
+            n = 0;
+        }
+    }
+
+    if (n) {
+        position->Append(pos_col, n);
+        side->Append(side_col, n);
+        best_move->Append(move_col, n);
+        outcome->Append(outcome_col, n);
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+bool Dataset::Close()
+{
+    bool ok = position->Close();
+    ok = side->Close() && ok;
+    ok = best_move->Close() && ok;
+    ok = outcome->Close() && ok;
+
+    return ok;
+}
+
+uint32_t Dataset::Canonical(uint16_t own, uint16_t opp) const
+{
+    uint32_t best = 0xffffffff;
+
+    for (int s = 0; s < Symmetry::count; s++) {
+        uint32_t key = sym.Apply(s, own) 
+                     | static_cast<uint32_t>(sym.Apply(s, opp)) << 16;
+        if (key < best) { best = key; }
+    }
+
+    return best;
+}
+
+bool Dataset::Insert(uint32_t key)
+{
+    /* Masks are disjoint, so key + 1 never wraps to the free mark */
+    uint32_t stored = key + 1;
+    uint32_t home = static_cast<uint32_t>((key * 0x9e3779b97f4a7c15ULL) >> 32)
+                  & seen_mask;
+
+    for (int i = 0; i < probe_count; i++) {
+        uint32_t &slot = seen[(home + i) & seen_mask];
+
+        if (slot == stored) { return false; }
+        if (slot == 0) {
+            slot = stored;
+            return true;
+        }
+    }
+
+    /* No room: the key overwrites its home slot, so the key that was
+       there may later be written again */
+    seen[home] = stored;
+    return true;
+}
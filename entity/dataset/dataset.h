@@ -0,0 +1,122 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATASET_H_SENTRY
+#define DATASET_H_SENTRY
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "../board/board.h"
+#include "../npy/npy.h"
+#include "../symmetry/symmetry.h"
+
+/**
+ * @class Dataset
+ * @brief Columnar export of self-play positions to .npy files.
+ * 
+ * Files in the directory, one row per position:
+ * - position.npy  uint8 (N, cells): 0 free, 1 side 0 mark, 2 side 1 mark
+ * - side.npy      uint8 (N,): side to move
+ * - best_move.npy int8 (N,): cell chosen by the bot
+ * - outcome.npy   int8 (N,): 1 win, 0 draw, -1 loss for the side to move
+ * 
+ * Positions equal under the symmetries of the square are written once.
+ * The table of seen positions has a fixed size: when a probe finds no
+ * room, the key overwrites its home slot, so memory stays bounded and
+ * only rare duplicates of the evicted key get through.
+ * 
+ * @note Boards of up to 16 cells.
+ */
+class Dataset {
+public:
+    /**
+     * @brief A position in the terms of the side to move.
+     */
+    struct row {
+        uint16_t own;           /**< Marks of the side to move */
+        uint16_t opp;           /**< Marks of the other side */
+        uint8_t side;           /**< Side to move */
+        int8_t move;            /**< Chosen cell */
+        int8_t outcome;         /**< 1, 0 or -1 for the side to move */
+    };
+
+private:
+    enum { probe_count = 8, chunk_rows = 4096 };
+
+    int cells;
+    Symmetry sym;
+
+    uint32_t *seen;             /**< Canonical keys + 1, 0 is free */
+    uint32_t seen_mask;         /**< Slots - 1 (power of two) */
+
+    NpyWriter *position;
+    NpyWriter *side;
+    NpyWriter *best_move;
+    NpyWriter *outcome;
+
+    pthread_mutex_t lock;       /**< Dataset::Add is called by threads */
+    unsigned long long duplicates;
+
+public:
+    /**
+     * @param dir Output directory, created if it doesn't exist.
+     * @param rules Board of the games.
+     * @param dedup_bytes Memory for the table of seen positions.
+     * 
+     * @throws const char * if files can't be created.
+     */
+    Dataset(const char *dir, const Board &rules, size_t dedup_bytes);
+    ~Dataset();
+
+    /**
+     * @brief Writes the rows that were not seen before.
+     */
+    void Add(const row *rows, int count);
+
+    /**
+     * @brief Completes the files.
+     * 
+     * @return false if any write has failed.
+     */
+    bool Close();
+
+    unsigned long long GetRows() const { return side->GetRows(); }
+    unsigned long long GetDuplicates() const { return duplicates; }
+
+private:
+    Dataset(Dataset &d);
+    void operator=(Dataset &d);
+
+    /**
+     * @brief The smallest key of the position among its 8 images.
+     */
+    uint32_t Canonical(uint16_t own, uint16_t opp) const;
+
+    /**
+     * @brief Inserts the key into the table of seen positions.
+     * 
+     * @return false if the key was already there.
+     */
+    bool Insert(uint32_t key);
+};
+
+#endif /* DATASET_H_SENTRY */
@@ -0,0 +1,289 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "dfpn.h"
+
+Dfpn::Dfpn(size_t table_bytes)
+    : table(0)
+    , table_size(1024)
+    , used(0)
+    , attacker(0)
+    , nodes(0)
+    , node_limit(0)
+    , search_nodes(0)
+    , collections(0)
+    , aborted(false)
+{
+    if (table_bytes < table_size * sizeof(entry)) { throw "Table is too small"; }
+
+    while (table_size * 2 * sizeof(entry) <= table_bytes) { table_size *= 2; }
+    table = new entry[table_size];
+    Clear();
+
+    /* A fixed key, so runs are reproducible */
+    Rng rng(0x7474742d6466706eULL);
+    attacker_key = rng.Next();
+}
+
+Dfpn::~Dfpn()
+{
+    delete[] table;
+}
+
+void Dfpn::Clear()
+{
+    memset(table, 0, table_size * sizeof(entry));
+    used = 0;
+}
+
+Dfpn::result Dfpn::Solve(Board &board, long long node_limit, int *best)
+{
+    int side = board.GetTurn();
+    int win_move = -1, hold_move = -1;
+
+    if (best) { *best = -1; }
+
+    int attack = Prove(board, side, node_limit, &win_move);
+    if (attack == 1) {
+        if (best) { *best = win_move; }
+        return win;
+    }
+
+    int defence = Prove(board, !side, node_limit, &hold_move);
+    if (defence == 1) { return loss; }
+    if (defence == -1) { return unknown; }
+
+    if (best) { *best = hold_move; }
+    return attack == 0 ? draw : unknown;
+}
+
+int Dfpn::Prove(Board &board, int side, long long node_limit, int *best)
+{
+    int last = board.GetLastMove();
+    int mover = board.GetTurn();
+    uint32_t phi, delta;
+
+    if (best) { *best = -1; }
+
+    /* The game is already over */
+    if (last != -1 && board.IsWinAt(last)) { return (!mover) == side; }
+    if (board.IsFull()) { return 0; }
+
+    attacker = side;
+    this->node_limit = node_limit;
+    search_nodes = 0;
+    aborted = false;
+
+    uint64_t hash = Hash(board);
+    Mid(board, hash, inf, inf, phi, delta);
+
+    if (phi != 0 && delta != 0) { return -1; }
+    if (phi == 0 && best) { *best = ProofMove(board, hash); }
+
+    /* phi is 0 if the side to move reaches its goal */
+    return (phi == 0) == (mover == attacker);
+}
+
+bool Dfpn::Terminal(Board &board, int cell, uint32_t &phi, uint32_t &delta) const
+{
+    bool over = true;
+
+    board.Make(cell);
+
+    /* The side to move has lost, or has drawn */
+    if (board.IsWinAt(cell)) {
+        phi = inf;
+        delta = 0;
+    }
+    else if (board.IsFull()) {
+        phi = board.GetTurn() == attacker ? inf : 0;
+        delta = board.GetTurn() == attacker ? 0 : inf;
+    }
+    else { over = false; }
+
+    board.Unmake();
+
+    return over;
+}
+
+void Dfpn::Mid(Board &board, uint64_t hash, uint32_t th_phi, uint32_t th_delta,
+               uint32_t &phi, uint32_t &delta)
+{
+    int turn = board.GetTurn();
+    int cell[Board::max_cells];
+    uint64_t child_hash[Board::max_cells];
+    uint32_t fixed_phi[Board::max_cells], fixed_delta[Board::max_cells];
+    bool fixed[Board::max_cells];
+    int n = 0;
+    long long start = search_nodes;
+
+    nodes++;
+    search_nodes++;
+    if (node_limit && search_nodes >= node_limit) { aborted = true; }
+
+    for (uint64_t free = board.GetFree(); free; free &= free - 1) {
+        cell[n] = __builtin_ctzll(free);
+        child_hash[n] = hash ^ Board::GetKey(turn, cell[n]);
+        fixed[n] = Terminal(board, cell[n], fixed_phi[n], fixed_delta[n]);
+        n++;
+    }
+
+    for (;;) {
+        uint32_t min_delta = inf, second = inf, best_phi = 0;
+        uint64_t sum = 0;
+        int best = -1;
+
+        for (int i = 0; i < n; i++) {
+            uint32_t c_phi = 1, c_delta = 1;
+
+            if (fixed[i]) {
+                c_phi = fixed_phi[i];
+                c_delta = fixed_delta[i];
+            }
+            else if (const entry *e = Lookup(child_hash[i])) {
+                c_phi = e->phi;
+                c_delta = e->delta;
+            }
+
+            if (c_delta < min_delta) {
+                second = min_delta;
+                min_delta = c_delta;
+                best_phi = c_phi;
+                best = i;
+            }
+            else if (c_delta < second) { second = c_delta; }
+
+            sum += c_phi;
+        }
+
+        /* The side to move needs one child to fail, or all to succeed */
+        phi = min_delta;
+        delta = sum >= inf ? inf : sum;
+
+        if (phi >= th_phi || delta >= th_delta || aborted) { break; }
+
+        uint64_t c_th_phi = uint64_t(th_delta) - delta + best_phi;
+        uint32_t c_th_delta = second == inf ? th_phi 
+                            : (second + 1 < th_phi ? second + 1 : th_phi);
+        uint32_t c_phi, c_delta;
+
+        board.Make(cell[best]);
+        Mid(board, child_hash[best], c_th_phi >= inf ? inf : c_th_phi, 
+            c_th_delta, c_phi, c_delta);
+        board.Unmake();
+    }
+
+    Store(hash, phi, delta, search_nodes - start);
+}
+
+const Dfpn::entry *Dfpn::Lookup(uint64_t hash) const
+{
+    const entry *c = table + (hash & (table_size - 1) & ~size_t(cluster - 1));
+
+    for (int i = 0; i < cluster; i++) {
+        if (c[i].key == hash) { return c + i; }
+    }
+
+    return 0;
+}
+
+void Dfpn::Store(uint64_t hash, uint32_t phi, uint32_t delta, uint64_t work)
+{
+    entry *c = table + (hash & (table_size - 1) & ~size_t(cluster - 1));
+    entry *slot = 0;
+
+    for (int i = 0; i < cluster; i++) {
+        if (c[i].key == hash) {
+            c[i].phi = phi;
+            c[i].delta = delta;
+            c[i].work += work;
+            return;
+        }
+    }
+
+    if (used >= table_size / 4 * 3) { Collect(); }
+
+    /* A free slot, otherwise the smallest subtree of the cluster */
+    for (int i = 0; i < cluster; i++) {
+        if (c[i].key == 0) {
+            slot = c + i;
+            used++;
+            break;
+        }
+        if (!slot || c[i].work < slot->work) { slot = c + i; }
+    }
+
+    slot->key = hash;
+    slot->phi = phi;
+    slot->delta = delta;
+    slot->work = work;
+}
+
+void Dfpn::Collect()
+{
+    size_t count[65];
+    size_t dropped = 0;
+    int limit = 0;
+
+    memset(count, 0, sizeof(count));
+
+    /* Entries by the bit length of their work */
+    for (size_t i = 0; i < table_size; i++) {
+        if (table[i].key) { count[64 - __builtin_clzll(table[i].work | 1)]++; }
+    }
+    while (limit < 64 && dropped < used / 2) { dropped += count[limit++]; }
+
+    for (size_t i = 0; i < table_size; i++) {
+        entry &e = table[i];
+        if (e.key && 64 - __builtin_clzll(e.work | 1) < limit) {
+            e.key = 0;
+            used--;
+        }
+    }
+
+    collections++;
+}
+
+int Dfpn::ProofMove(Board &board, uint64_t hash) const
+{
+    int turn = board.GetTurn();
+
+    for (uint64_t free = board.GetFree(); free; free &= free - 1) {
+        int cell = __builtin_ctzll(free);
+        uint32_t phi, delta;
+
+        if (Terminal(board, cell, phi, delta)) {
+            if (delta == 0) { return cell; }
+            continue;
+        }
+
+        const entry *e = Lookup(hash ^ Board::GetKey(turn, cell));
+        if (e && e->delta == 0) { return cell; }
+    }
+
+    return -1;
+}
+
+uint64_t Dfpn::Hash(const Board &board) const
+{
+    return board.GetHash() ^ (attacker ? attacker_key : 0);
+}
@@ -0,0 +1,150 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DFPN_H_SENTRY
+#define DFPN_H_SENTRY
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../board/board.h"
+#include "../rng/rng.h"
+
+/**
+ * @class Dfpn
+ * @brief Depth-first proof-number search (df-pn) of k-in-a-row games.
+ * 
+ * A search proves or disproves that the attacker wins, a draw counts
+ * as a failure of the attacker. Dfpn::Solve runs it for both sides to
+ * tell a win, a draw and a loss apart.
+ * 
+ * Proof and disproof numbers are kept from the side to move (phi and
+ * delta) in a transposition table of fixed size. When the table gets
+ * full, a garbage collection drops the entries with the smallest
+ * subtrees until half of it is free, so memory never grows and
+ * expensive results survive.
+ */
+class Dfpn {
+public:
+    enum result { loss = -1, draw = 0, win = 1, unknown = 2 };
+
+private:
+    enum { inf = 0x7fffffff, cluster = 4 };
+
+    struct entry {
+        uint64_t key;           /**< Zobrist hash, 0 is a free slot */
+        uint32_t phi;           /**< Proof number for the side to move */
+        uint32_t delta;         /**< Disproof number */
+        uint64_t work;          /**< Nodes searched below the entry */
+    };
+
+    entry *table;
+    size_t table_size;          /**< Entries, a power of two */
+    size_t used;                /**< Occupied entries */
+    uint64_t attacker_key;      /**< Hashed in if side 1 attacks */
+
+    int attacker;               /**< Side that has to win */
+    long long nodes;            /**< Expanded positions of all searches */
+    long long node_limit;       /**< Of one Dfpn::Prove, 0 - no limit */
+    long long search_nodes;     /**< Of the running Dfpn::Prove */
+    long long collections;      /**< Garbage collections */
+    bool aborted;               /**< Out of nodes */
+
+public:
+    /**
+     * @param table_bytes Memory of the transposition table.
+     * 
+     * @throws const char * if the memory is too small.
+     */
+    explicit Dfpn(size_t table_bytes);
+    ~Dfpn();
+
+    /**
+     * @brief Result of the game for the side to move.
+     * 
+     * @param board Position, restored before return.
+     * @param node_limit Nodes of each of the two searches, 0 - no limit.
+     * @param[out] best Winning move if the result is a win, otherwise
+     *                  a move that doesn't lose if there is a proof.
+     *                  -1 if unknown (can be NULL).
+     * 
+     * @return Dfpn::unknown if a search ran out of nodes.
+     */
+    result Solve(Board &board, long long node_limit, int *best = 0);
+
+    /**
+     * @brief Proves or disproves that the side wins.
+     * 
+     * @param board Position, restored before return.
+     * @param[out] best Move that reaches the goal of the side to move
+     *                  (a win for the attacker, no loss for the
+     *                  defender), -1 if there is none or it's unknown.
+     * 
+     * @return 1 if proven, 0 if disproven, -1 if out of nodes.
+     */
+    int Prove(Board &board, int side, long long node_limit, int *best = 0);
+
+    /**
+     * @brief Drops all entries, the statistics are kept.
+     */
+    void Clear();
+
+    long long GetNodes() const { return nodes; }
+    long long GetCollections() const { return collections; }
+    size_t GetUsed() const { return used; }
+    size_t GetBytes() const { return table_size * sizeof(entry); }
+
+private:
+    Dfpn(Dfpn &d);
+    void operator=(Dfpn &d);
+
+    /**
+     * @brief Expands the node until its phi or delta reaches the bound.
+     * 
+     * @param hash Zobrist hash of the position.
+     * @param[out] phi, delta Numbers of the node on return.
+     */
+    void Mid(Board &board, uint64_t hash, uint32_t th_phi, uint32_t th_delta,
+             uint32_t &phi, uint32_t &delta);
+
+    /**
+     * @brief Numbers of a position after the move if it ends the game.
+     * 
+     * @return false if the game goes on.
+     */
+    bool Terminal(Board &board, int cell, uint32_t &phi, uint32_t &delta) const;
+
+    const entry *Lookup(uint64_t hash) const;
+    void Store(uint64_t hash, uint32_t phi, uint32_t delta, uint64_t work);
+
+    /**
+     * @brief Frees at least half of the table, small subtrees first.
+     */
+    void Collect();
+
+    /**
+     * @brief The proof move from the table (phi of the root is 0).
+     */
+    int ProofMove(Board &board, uint64_t hash) const;
+
+    uint64_t Hash(const Board &board) const;
+};
+
+#endif /* DFPN_H_SENTRY */
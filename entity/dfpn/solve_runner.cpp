@@ -0,0 +1,91 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "solve_runner.h"
+#include "../stats/stats.h"
+
+SolveRunner::SolveRunner(int argc, char **argv)
+    : size(3)
+    , k(0)
+    , node_limit(0)
+    , table_bytes(256UL << 20)
+{
+    for (int i = 0; i < argc; i++) {
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--size") == 0) { size = atoi(val); }
+        else if (strcmp(argv[i - 1], "--k") == 0) { k = atoi(val); }
+        else if (strcmp(argv[i - 1], "--nodes") == 0) { node_limit = atoll(val); }
+        else if (strcmp(argv[i - 1], "--tt-mb") == 0) { 
+            long mb = atol(val);
+            if (mb < 1) { throw "Bad option value"; }
+            table_bytes = static_cast<size_t>(mb) << 20; 
+        }
+        else { throw "Unknown option"; }
+    }
+
+    if (k == 0) { k = size; }
+    if (node_limit < 0) { throw "Bad option value"; }
+
+    /* Validates the size and k */
+    Board check(size, k);
+}
+
+void SolveRunner::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s solve [options]\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --nodes N            node limit of each search (none)\n"
+            "  --tt-mb N            transposition table size (256)\n", name);
+}
+
+int SolveRunner::Run()
+{
+    static const char *names[] = { "loss", "draw", "win", "unknown" };
+    Board board(size, k);
+    Dfpn dfpn(table_bytes);
+    uint64_t start = Stats::Now();
+    char move[4];
+    int best;
+
+    Dfpn::result r = dfpn.Solve(board, node_limit, &best);
+
+    double sec = (Stats::Now() - start) / 1e9;
+
+    printf("%dx%d k=%d: %s for the first player\n", size, size, k, 
+           names[r + 1]);
+    if (best != -1) {
+        board.FormatMove(best, move);
+        printf("first move %s %s\n", move, r == Dfpn::win ? "wins" : "does not lose");
+    }
+    printf("%lld nodes in %.3f s (%.0f nodes/s)\n"
+           "table %zu MB, %zu entries used, %lld collections\n",
+           dfpn.GetNodes(), sec, dfpn.GetNodes() / (sec > 0 ? sec : 1),
+           dfpn.GetBytes() >> 20, dfpn.GetUsed(), dfpn.GetCollections());
+
+    return r == Dfpn::unknown ? 2 : 0;
+}
@@ -0,0 +1,56 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLVE_RUNNER_H_SENTRY
+#define SOLVE_RUNNER_H_SENTRY
+
+#include "dfpn.h"
+
+/**
+ * @class SolveRunner
+ * @brief Theoretical result of the empty board ("ttt solve").
+ */
+class SolveRunner {
+private:
+    int size, k;
+    long long node_limit;
+    size_t table_bytes;
+
+public:
+    /**
+     * @param argc, argv Options after "solve", see SolveRunner::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    SolveRunner(int argc, char **argv);
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    SolveRunner(SolveRunner &r);
+    void operator=(SolveRunner &r);
+};
+
+#endif /* SOLVE_RUNNER_H_SENTRY */
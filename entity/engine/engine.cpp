@@ -0,0 +1,286 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include "engine.h"
+
+Engine::Engine(int in_fd)
+    : go_pending(false)
+    , infinite(false)
+    , searching(false)
+    , exiting(false)
+    , stop(0)
+{
+    board = new Board();
+    search_board = new Board();
+    bot = new Bot("engine", 'O');
+    reader = new LineReader(in_fd);
+
+    memset(&limits, 0, sizeof(limits));
+
+    pthread_mutex_init(&lock, 0);
+    pthread_mutex_init(&out_lock, 0);
+    pthread_cond_init(&wake, 0);
+    pthread_cond_init(&idle, 0);
+
+    if (pthread_create(&worker, 0, Worker, this) != 0) { 
+        throw "Can't start the search thread"; 
+    }
+}
+
+Engine::~Engine()
+{
+    Stop();
+
+    pthread_mutex_lock(&lock);
+    exiting = true;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+
+    pthread_join(worker, 0);
+
+    pthread_cond_destroy(&idle);
+    pthread_cond_destroy(&wake);
+    pthread_mutex_destroy(&out_lock);
+    pthread_mutex_destroy(&lock);
+
+    delete reader;
+    delete bot;
+    delete search_board;
+    delete board;
+}
+
+int Engine::Run()
+{
+    char buff[4096];
+    const char *line;
+    size_t len;
+
+    while ((line = reader->ReadLine(&len)) != 0) {
+        if (len >= sizeof(buff)) { len = sizeof(buff) - 1; }
+        memcpy(buff, line, len);
+        buff[len] = '\0';
+
+        if (!Command(buff)) { break; }
+    }
+
+    Stop();
+    return 0;
+}
+
+bool Engine::Command(char *line)
+{
+    char *save;
+    char *cmd = strtok_r(line, " \t", &save);
+
+    if (!cmd) { return true; }
+
+    if (strcmp(cmd, "go") == 0) { Go(&save); }
+    else if (strcmp(cmd, "position") == 0) { Position(&save); }
+    else if (strcmp(cmd, "stop") == 0) { Stop(); }
+    else if (strcmp(cmd, "isready") == 0) { Reply("readyok"); }
+    else if (strcmp(cmd, "newgame") == 0) { NewGame(&save); }
+    else if (strcmp(cmd, "quit") == 0) { return false; }
+    else { Reply("info string unknown command %s", cmd); }
+
+    return true;
+}
+
+void Engine::NewGame(char **save)
+{
+    const char *size_str = strtok_r(0, " \t", save);
+    const char *k_str = strtok_r(0, " \t", save);
+    int size = size_str ? atoi(size_str) : 3;
+    int k = k_str ? atoi(k_str) : size;
+
+    Stop();
+
+    try {
+        Board *b = new Board(size, k);
+        delete board;
+        board = b;
+    }
+    catch (const char *err) {
+        Reply("info string %s", err);
+    }
+}
+
+void Engine::Position(char **save)
+{
+    const char *tok;
+
+    Stop();
+    board->Clear();
+
+    while ((tok = strtok_r(0, " \t", save)) != 0) {
+        if (strcmp(tok, "startpos") == 0 || strcmp(tok, "moves") == 0) {
+            continue;
+        }
+
+        int cell = board->ParseMove(tok);
+        int last = board->GetLastMove();
+
+        if (cell < 0 || (last >= 0 && board->IsWinAt(last))) {
+            Reply("info string illegal move %s", tok);
+            break;
+        }
+
+        board->Make(cell);
+    }
+}
+
+void Engine::Go(char **save)
+{
+    Bot::search_limits lim;
+    const char *tok;
+    bool inf = false;
+
+    memset(&lim, 0, sizeof(lim));
+
+    while ((tok = strtok_r(0, " \t", save)) != 0) {
+        const char *val;
+
+        if (strcmp(tok, "infinite") == 0) { 
+            inf = true;
+            continue; 
+        }
+
+        val = strtok_r(0, " \t", save);
+        if (!val) { break; }
+
+        if (strcmp(tok, "depth") == 0) { lim.depth = atoi(val); }
+        else if (strcmp(tok, "movetime") == 0) { lim.movetime = atol(val); }
+        else if (strcmp(tok, "nodes") == 0) { lim.nodes = atoll(val); }
+    }
+
+    Stop();
+
+    pthread_mutex_lock(&lock);
+    *search_board = *board;
+    limits = lim;
+    infinite = inf;
+    __atomic_store_n(&stop, 0, __ATOMIC_RELAXED);
+    go_pending = true;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+}
+
+void Engine::Stop()
+{
+    /* Under the lock: the worker may hold an infinite search result */
+    pthread_mutex_lock(&lock);
+    __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    Wait();
+}
+
+void Engine::Wait()
+{
+    pthread_mutex_lock(&lock);
+    while (go_pending || searching) { pthread_cond_wait(&idle, &lock); }
+    pthread_mutex_unlock(&lock);
+}
+
+void Engine::Reply(const char *fmt, ...)
+{
+    va_list args;
+
+    pthread_mutex_lock(&out_lock);
+
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+
+    putc('\n', stdout);
+    fflush(stdout);
+
+    pthread_mutex_unlock(&out_lock);
+}
+
+void *Engine::Worker(void *arg)
+{
+    Engine *e = static_cast<Engine *>(arg);
+
+    pthread_mutex_lock(&e->lock);
+
+    for (;;) {
+        while (!e->go_pending && !e->exiting) { 
+            pthread_cond_wait(&e->wake, &e->lock); 
+        }
+        if (!e->go_pending) { break; }
+
+        e->go_pending = false;
+        e->searching = true;
+        pthread_mutex_unlock(&e->lock);
+
+        char move[3];
+        int best = e->bot->Search(*e->search_board, e->limits, &e->stop, 
+                                  Info, e);
+
+        /* An infinite search is answered only after stop or quit */
+        pthread_mutex_lock(&e->lock);
+        while (e->infinite && !__atomic_load_n(&e->stop, __ATOMIC_RELAXED)) {
+            pthread_cond_wait(&e->wake, &e->lock);
+        }
+        pthread_mutex_unlock(&e->lock);
+
+        if (best >= 0) {
+            e->search_board->FormatMove(best, move);
+            e->Reply("bestmove %s", move);
+        }
+        else { e->Reply("bestmove none"); }
+
+        pthread_mutex_lock(&e->lock);
+        e->searching = false;
+        pthread_cond_broadcast(&e->idle);
+    }
+
+    pthread_mutex_unlock(&e->lock);
+    return 0;
+}
+
+void Engine::Info(const Bot::search_info &info, void *data)
+{
+    Engine *e = static_cast<Engine *>(data);
+    char move[3];
+    const char *kind = "cp";
+    int score = info.score;
+    long long nps = info.nodes * 1000000 / (info.time > 0 ? info.time : 1);
+
+    /* Proven results are reported in moves to the end of the game */
+    if (score > Bot::score_proven) {
+        kind = "mate";
+        score = (Bot::score_win - score + 1) / 2;
+    }
+    else if (score < -Bot::score_proven) {
+        kind = "mate";
+        score = -(Bot::score_win + score + 1) / 2;
+    }
+
+    e->search_board->FormatMove(info.best, move);
+    e->Reply("info depth %d score %s %d nodes %lld nps %lld time %lld pv %s",
+             info.depth, kind, score, info.nodes, nps, info.time / 1000, move);
+}
@@ -0,0 +1,119 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENGINE_H_SENTRY
+#define ENGINE_H_SENTRY
+
+#include <pthread.h>
+
+#include "../board/board.h"
+#include "../bot/bot.h"
+#include "../line_reader/line_reader.h"
+
+/**
+ * @class Engine
+ * @brief Line-based text protocol that drives Bot::Search.
+ * 
+ * Commands (one per line):
+ * - newgame [size [k]]   Empty board, 3x3 with 3 in a row by default.
+ * - position [moves] m.. Empty board and the moves, e.g. "11 00 22".
+ * - go [depth D] [movetime MS] [nodes N] [infinite]
+ *                        With infinite, bestmove waits for stop.
+ * - stop                 Stops the search, bestmove is printed.
+ * - isready              Answered by "readyok".
+ * - quit
+ * 
+ * Replies:
+ * - info depth D score cp|mate S nodes N nps N time MS pv M
+ * - bestmove M           M is "none" if the game is over.
+ * 
+ * The search runs in a worker thread, so the protocol loop keeps 
+ * reading commands (e.g. "stop") during it.
+ */
+class Engine {
+private:
+    Board *board;               /**< Current position */
+    Bot *bot;                   /**< Owner of the search */
+    LineReader *reader;         /**< Commands */
+
+    pthread_t worker;
+    pthread_mutex_t lock;       /**< Guards the fields below */
+    pthread_cond_t wake;        /**< A search is requested or exiting */
+    pthread_cond_t idle;        /**< A search is over */
+    pthread_mutex_t out_lock;   /**< Serializes the output */
+
+    Board *search_board;        /**< Copy of the position for the worker */
+    Bot::search_limits limits;  /**< Limits of the requested search */
+    bool go_pending;            /**< A search is requested */
+    bool infinite;              /**< bestmove waits for Engine::Stop */
+    bool searching;             /**< The worker is busy */
+    bool exiting;               /**< The worker must exit */
+    int stop;                   /**< Passed to Bot::Search */
+
+public:
+    /**
+     * @param in_fd Source of the commands.
+     */
+    Engine(int in_fd);
+    ~Engine();
+
+    /**
+     * @brief Runs the protocol loop until "quit" or the end of input.
+     * 
+     * @return Exit status of the program.
+     */
+    int Run();
+
+private:
+    Engine(Engine &e);
+    void operator=(Engine &e);
+
+    /**
+     * @brief Handles a single command.
+     * 
+     * @param line Command, modified by the tokenizer.
+     * @return false on "quit", true otherwise.
+     */
+    bool Command(char *line);
+
+    void NewGame(char **save);
+    void Position(char **save);
+    void Go(char **save);
+
+    /**
+     * @brief Aborts the running search and waits for its bestmove.
+     */
+    void Stop();
+
+    /**
+     * @brief Waits until the worker is idle.
+     */
+    void Wait();
+
+    /**
+     * @brief Prints a line of reply at once.
+     */
+    void Reply(const char *fmt, ...);
+
+    static void *Worker(void *arg);
+    static void Info(const Bot::search_info &info, void *data);
+};
+
+#endif /* ENGINE_H_SENTRY */
@@ -0,0 +1,360 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "enumerator.h"
+#include "../stats/stats.h"
+
+Enumerator::Enumerator(int argc, char **argv)
+    : size(3)
+    , k(0)
+    , depth(0)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , table_bytes(128UL << 20)
+    , solved(0)
+    , bits(0)
+    , keys(0)
+    , key_count(0)
+    , key_used(0)
+    , frontier(0)
+    , next(0)
+    , frontier_count(0)
+    , next_count(0)
+    , next_item(0)
+    , overflow(false)
+{
+    for (int i = 0; i < argc; i++) {
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--size") == 0) { size = atoi(val); }
+        else if (strcmp(argv[i - 1], "--k") == 0) { k = atoi(val); }
+        else if (strcmp(argv[i - 1], "--depth") == 0) { depth = atoi(val); }
+        else if (strcmp(argv[i - 1], "--threads") == 0) { threads = atoi(val); }
+        else if (strcmp(argv[i - 1], "--mb") == 0) { 
+            long mb = atol(val);
+            if (mb < 1) { throw "Bad option value"; }
+            table_bytes = static_cast<size_t>(mb) << 20; 
+        }
+        else { throw "Unknown option"; }
+    }
+
+    if (k == 0) { k = size; }
+    if (threads < 1) { threads = 1; }
+
+    Board rules(size, k);
+
+    cells = size * size;
+    if (cells > 32) { throw "Board is too large to enumerate"; }
+    if (depth == 0) { depth = cells; }
+    if (depth < 1 || depth > cells) { throw "Bad depth"; }
+
+    /* Bit 0 mirrors columns, bit 1 mirrors rows, bit 2 transposes */
+    for (int s = 0; s < symmetry_count; s++) {
+        for (int cell = 0; cell < cells; cell++) {
+            int r = cell / size, c = cell % size, t;
+
+            if (s & 1) { c = size - 1 - c; }
+            if (s & 2) { r = size - 1 - r; }
+            if (s & 4) { 
+                t = r;
+                r = c;
+                c = t;
+            }
+            perm[s][cell] = r * size + c;
+        }
+    }
+
+    pow3[0] = 1;
+    for (int i = 1; i <= Solved::max_cells; i++) { pow3[i] = pow3[i - 1] * 3; }
+
+    size_t capacity;
+    if (cells <= 9) {
+        bits = new uint64_t[pow3[cells] / 64 + 1];
+        capacity = pow3[cells];
+    }
+    else {
+        key_count = 1;
+        while (key_count * 2 * sizeof(uint64_t) <= table_bytes) { key_count *= 2; }
+        keys = new uint64_t[key_count];
+
+        /* At most half full, the probes stay short */
+        capacity = key_count / 2;
+    }
+    frontier = new uint64_t[capacity];
+    next = new uint64_t[capacity];
+
+    if (cells <= Solved::max_cells) { solved = new Solved(rules); }
+}
+
+Enumerator::~Enumerator()
+{
+    delete solved;
+    delete[] next;
+    delete[] frontier;
+    delete[] keys;
+    delete[] bits;
+}
+
+void Enumerator::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s enumerate [options]\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --depth D            plies to enumerate (all cells)\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --mb N               visited set above 9 cells (128)\n", 
+            name);
+}
+
+int Enumerator::Run()
+{
+    counts total;
+    uint64_t run_start = Stats::Now();
+    pthread_t *tid = new pthread_t[threads];
+    size_t set_bytes = bits ? (pow3[cells] / 64 + 1) * sizeof(uint64_t)
+                            : key_count * sizeof(uint64_t);
+
+    memset(&total, 0, sizeof(total));
+
+    printf("positions of %dx%d k=%d, %d threads, %s of %zu KB\n", 
+           size, size, k, threads, bits ? "bitset" : "hash table", 
+           set_bytes >> 10);
+    printf("%4s %12s %10s %10s %10s %10s %10s %9s %9s\n", "ply", "positions", 
+           "terminal", "canonical", "wins", "draws", "losses", "ms", "KB");
+
+    /* Ply 0: the empty board */
+    frontier[0] = 0;
+    frontier_count = 1;
+    memset(&ply_counts, 0, sizeof(ply_counts));
+    ply_counts.positions = ply_counts.canonical = 1;
+    if (solved) {
+        Solved::value v = solved->GetValue(0);
+        if (v == Solved::win) { ply_counts.wins = 1; }
+        if (v == Solved::draw) { ply_counts.draws = 1; }
+        if (v == Solved::loss) { ply_counts.losses = 1; }
+    }
+
+    for (int ply = 0; ; ply++) {
+        uint64_t start = Stats::Now();
+        int started = 0;
+
+        if (ply > 0) {
+            memset(&ply_counts, 0, sizeof(ply_counts));
+            if (bits) { memset(bits, 0, set_bytes); }
+            else { memset(keys, 0, set_bytes); }
+            key_used = 0;
+            next_count = 0;
+            next_item = 0;
+
+            for (; started < threads; started++) {
+                if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+            }
+            if (started == 0) { Worker(this); }
+            for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+
+            if (__atomic_load_n(&overflow, __ATOMIC_RELAXED)) {
+                fprintf(stderr, "ply %d: the visited set is full, raise --mb\n", ply);
+                delete[] tid;
+                return 1;
+            }
+
+            uint64_t *t = frontier;
+            frontier = next;
+            next = t;
+            frontier_count = next_count;
+        }
+
+        if (solved) {
+            printf("%4d %12lld %10lld %10lld %10lld %10lld %10lld", ply, 
+                   ply_counts.positions, ply_counts.terminal, 
+                   ply_counts.canonical, ply_counts.wins, ply_counts.draws,
+                   ply_counts.losses);
+        }
+        else {
+            printf("%4d %12lld %10lld %10lld %10s %10s %10s", ply, 
+                   ply_counts.positions, ply_counts.terminal, 
+                   ply_counts.canonical, "-", "-", "-");
+        }
+        printf(" %9.1f %9zu\n", (Stats::Now() - start) / 1e6, 
+               (set_bytes + 2 * static_cast<size_t>(frontier_count) 
+                            * sizeof(uint64_t)) >> 10);
+
+        total.positions += ply_counts.positions;
+        total.terminal += ply_counts.terminal;
+        total.canonical += ply_counts.canonical;
+        total.wins += ply_counts.wins;
+        total.draws += ply_counts.draws;
+        total.losses += ply_counts.losses;
+
+        if (ply == depth || frontier_count == 0) { break; }
+    }
+
+    delete[] tid;
+
+    printf("total %lld positions, %lld terminal, %lld canonical", 
+           total.positions, total.terminal, total.canonical);
+    if (solved) {
+        printf(", %lld wins, %lld draws, %lld losses", 
+               total.wins, total.draws, total.losses);
+    }
+    printf(" in %.3f s\n", (Stats::Now() - run_start) / 1e9);
+
+    return 0;
+}
+
+void *Enumerator::Worker(void *arg)
+{
+    static_cast<Enumerator *>(arg)->Expand();
+    return 0;
+}
+
+void Enumerator::Expand()
+{
+    Board board(size, k);
+    counts c;
+
+    memset(&c, 0, sizeof(c));
+
+    for (;;) {
+        long long first = __atomic_fetch_add(&next_item, chunk, __ATOMIC_RELAXED);
+        if (first >= frontier_count) { break; }
+
+        long long last = first + chunk < frontier_count ? first + chunk 
+                                                        : frontier_count;
+        for (long long i = first; i < last; i++) {
+            uint64_t key = frontier[i];
+            int side;
+
+            board.SetPosition(key & 0xffffffff, key >> 32);
+            side = board.GetTurn();
+
+            for (uint64_t free = board.GetFree(); free; free &= free - 1) {
+                int cell = __builtin_ctzll(free);
+                uint64_t child = key | uint64_t(1) << (cell + 32 * side);
+
+                if (!Insert(child)) { continue; }
+
+                c.positions++;
+                if (IsCanonical(child)) { c.canonical++; }
+
+                board.Make(cell);
+
+                if (board.IsWinAt(cell)) {
+                    /* The side to move has lost */
+                    c.terminal++;
+                    c.losses++;
+                }
+                else if (board.IsFull()) {
+                    c.terminal++;
+                    c.draws++;
+                }
+                else {
+                    long long n = __atomic_fetch_add(&next_count, 1, __ATOMIC_RELAXED);
+                    next[n] = child;
+
+                    if (solved) {
+                        Solved::value v = solved->GetValue(Code(child));
+                        if (v == Solved::win) { c.wins++; }
+                        if (v == Solved::draw) { c.draws++; }
+                        if (v == Solved::loss) { c.losses++; }
+                    }
+                }
+
+                board.Unmake();
+            }
+        }
+    }
+
+    __atomic_fetch_add(&ply_counts.positions, c.positions, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ply_counts.terminal, c.terminal, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ply_counts.canonical, c.canonical, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ply_counts.wins, c.wins, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ply_counts.draws, c.draws, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ply_counts.losses, c.losses, __ATOMIC_RELAXED);
+}
+
+bool Enumerator::Insert(uint64_t key)
+{
+    if (bits) {
+        uint32_t code = Code(key);
+        uint64_t bit = uint64_t(1) << (code & 63);
+        
+        return !(__atomic_fetch_or(&bits[code >> 6], bit, __ATOMIC_RELAXED) & bit);
+    }
+
+    /* The high bits of a multiply, then linear probing */
+    size_t mask = key_count - 1;
+    size_t i = (key * 0x9e3779b97f4a7c15ULL) >> 32 & mask;
+
+    for (size_t n = 0; n <= mask; n++, i = (i + 1) & mask) {
+        uint64_t expected = 0;
+
+        if (__atomic_load_n(&keys[i], __ATOMIC_RELAXED) == key) { return false; }
+        if (__atomic_compare_exchange_n(&keys[i], &expected, key, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            /* Half full is the limit, the frontier has as many slots */
+            if (__atomic_add_fetch(&key_used, 1, __ATOMIC_RELAXED) > key_count / 2) {
+                __atomic_store_n(&overflow, true, __ATOMIC_RELAXED);
+                return false;
+            }
+            return true;
+        }
+        if (expected == key) { return false; }
+    }
+
+    __atomic_store_n(&overflow, true, __ATOMIC_RELAXED);
+    return false;
+}
+
+bool Enumerator::IsCanonical(uint64_t key) const
+{
+    for (int s = 1; s < symmetry_count; s++) {
+        uint64_t image = 0;
+
+        for (uint64_t m = key; m; m &= m - 1) {
+            int bit = __builtin_ctzll(m);
+            int half = bit & 32;
+            image |= uint64_t(1) << (perm[s][bit - half] + half);
+        }
+
+        if (image < key) { return false; }
+    }
+
+    return true;
+}
+
+uint32_t Enumerator::Code(uint64_t key) const
+{
+    uint32_t code = 0;
+
+    for (uint64_t m = key; m; m &= m - 1) {
+        int bit = __builtin_ctzll(m);
+        code += bit < 32 ? pow3[bit] : 2 * pow3[bit - 32];
+    }
+
+    return code;
+}
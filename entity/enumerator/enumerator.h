@@ -0,0 +1,141 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENUMERATOR_H_SENTRY
+#define ENUMERATOR_H_SENTRY
+
+#include <stdint.h>
+
+#include "../board/board.h"
+#include "../solved/solved.h"
+
+/**
+ * @class Enumerator
+ * @brief Reachable positions of the empty board by ply ("ttt enumerate").
+ * 
+ * The game graph is walked breadth first: the positions of a ply are
+ * expanded by every free cell and the children are deduplicated in a
+ * visited set of the next ply. Up to 9 cells the set is a bitset over
+ * the base 3 codes, larger boards use an open-addressing table of the
+ * two masks packed into 64 bits (up to 32 cells). Both are shared by
+ * the threads without locks.
+ * 
+ * A move ends the game on a win or a full field, checked by
+ * Board::IsWinAt as in play; such positions are counted as terminal and
+ * not expanded. A position is canonical if its key is the smallest
+ * among its 8 rotations and reflections, so every class of symmetric
+ * positions is counted once. Boards of up to Solved::max_cells also get
+ * the perfect-play result for the side to move.
+ */
+class Enumerator {
+private:
+    enum { chunk = 1024, symmetry_count = 8 };
+
+    /**
+     * @struct counts
+     * @brief Statistics of one ply.
+     * 
+     * @var wins, draws, losses For the side to move, if solved.
+     */
+    struct counts {
+        long long positions;
+        long long terminal;
+        long long canonical;
+        long long wins, draws, losses;
+    };
+
+    int size, k, cells;
+    int depth;                  /**< Plies to enumerate */
+    int threads;
+    size_t table_bytes;         /**< Visited set of the large boards */
+
+    Solved *solved;             /**< NULL if the board is too large */
+    uint8_t perm[symmetry_count][Board::max_cells];  /**< Image of a cell */
+    uint32_t pow3[Solved::max_cells + 1];
+
+    /* Visited set of the ply being built, one of the two */
+    uint64_t *bits;             /**< By base 3 code, up to 9 cells */
+    uint64_t *keys;             /**< Open addressing, 0 is a free slot */
+    size_t key_count;           /**< Slots, a power of two */
+    size_t key_used;            /**< Occupied slots */
+
+    uint64_t *frontier;         /**< Open positions of the current ply */
+    uint64_t *next;             /**< Open positions of the next ply */
+    long long frontier_count;
+    long long next_count;
+    long long next_item;        /**< Next frontier position to expand */
+
+    counts ply_counts;          /**< Of the ply being built */
+    bool overflow;              /**< The visited set is full, atomic */
+
+public:
+    /**
+     * @param argc, argv Options after "enumerate", see Enumerator::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Enumerator(int argc, char **argv);
+    ~Enumerator();
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Enumerator(Enumerator &e);
+    void operator=(Enumerator &e);
+
+    static void *Worker(void *arg);
+
+    /**
+     * @brief Expands a share of the frontier into the next ply.
+     */
+    void Expand();
+
+    /**
+     * @brief Marks the position as visited.
+     * 
+     * @return true if it wasn't visited before.
+     */
+    bool Insert(uint64_t key);
+
+    /**
+     * @return The key is the smallest of its symmetric images.
+     */
+    bool IsCanonical(uint64_t key) const;
+
+    /**
+     * @brief Packs the masks: side 0 in the low half, side 1 in the high.
+     */
+    static uint64_t Key(uint64_t mask0, uint64_t mask1) 
+        { return mask0 | mask1 << 32; }
+
+    /**
+     * @brief Base 3 code (digit 1 for side 0, 2 for side 1).
+     * 
+     * @note Up to Solved::max_cells cells.
+     */
+    uint32_t Code(uint64_t key) const;
+};
+
+#endif /* ENUMERATOR_H_SENTRY */
@@ -23,56 +23,146 @@
 #include <string.h>
 #include <pwd.h>
 #include <stdlib.h>
-#include <time.h>
 
 #include "game.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
 
-Game::Game()
+Game::Game(const char *variant_name)
     : prompt('>')
+    , batch(false)
+    , batch_games(0)
 {
+    variant = Variant::Create(variant_name);
+    if (!variant) { throw "Unknown variant"; }
+
+    redo_cells = new int[variant->GetRows() * variant->GetCols()];
+    redo_count = 0;
+
     passwd *pw = getpwuid(geteuid());
     plr[man] = pw ? new Player(pw->pw_name, 'X') : new Player("Player", 'X');
 
-    plr[bot] = new Bot("><[O_O]><", 'O');
-    ui = new ConsoleUI();
+    plr[bot] = new Player("><[O_O]><", 'O');
+    out = &OutputSink::Stdout();
+    ui = CreateUI();
     terminal = new Terminal();
+    reader = new LineReader(STDIN_FILENO);
+    clock = 0;
+    broadcast = 0;
+
+    memset(batch_stat, 0, sizeof(batch_stat));
+}
+
+Game::Game(int script_fd, const char *variant_name)
+    : terminal(0)
+    , prompt('>')
+    , batch(true)
+    , batch_games(0)
+{
+    variant = Variant::Create(variant_name);
+    if (!variant) { throw "Unknown variant"; }
+
+    redo_cells = new int[variant->GetRows() * variant->GetCols()];
+    redo_count = 0;
+
+    plr[man] = new Player("Player", 'X');
+    plr[bot] = new Player("><[O_O]><", 'O');
+    out = &OutputSink::Stdout();
+    ui = CreateUI();
+    reader = new LineReader(script_fd);
+    clock = 0;
+    broadcast = 0;
+
+    memset(batch_stat, 0, sizeof(batch_stat));
 }
 
 Game::~Game()
 {
+    /* The result stays on the normal screen */
+    ui->LeaveScreen(true);
+
     delete plr[man];
     delete plr[bot];
     delete ui;
     delete terminal;
+    delete reader;
+    delete clock;
+    delete broadcast;
+    delete variant;
+    delete[] redo_cells;
 }
 
 Game::pmove_t Game::Start()
 {
-    int rowi, coli, curr_plr_i;
+    int cell, curr_plr_i;
     pmove_t res_move;
 
-    terminal->DisableICanon(0, 1);
-    terminal->DisableEcho();
+    if (batch) { return StartBatch(); }
+
+    if (ui->EnterScreen()) { 
+        terminal->SetSignalText(ConsoleUI::screen_off, ConsoleUI::screen_on); 
+    }
+    terminal->Apply(Terminal::raw, 0, 1);
 
     curr_plr_i = Intro();
 
-    terminal->DisableICanon(0, 4);
-    terminal->EnableEcho();
+    /* Moves are read by lines */
+    terminal->Apply(Terminal::cooked);
 
     for (int i = 0, move = 0, swtch = 0; ; i++, curr_plr_i = !curr_plr_i) {
+        TraceSpan span("Game::Start iteration", "ply", i);
+
+        if (clock) {
+            clock->Start(static_cast<player_i>(curr_plr_i));
+            ShowClock(false);
+        }
         ui->Print(ConsoleUI::game_time, plr[curr_plr_i]);
+        if (broadcast) { broadcast->Panel(ConsoleUI::game_time, curr_plr_i); }
 
         swtch = !swtch;
         if (swtch) { move++; }
 
         for (bool run = true; run;) {
-            res_move = ProcessPlayerMove(move, rowi, coli, 
+            res_move = ProcessPlayerMove(move, cell, 
                                          static_cast<player_i>(curr_plr_i));
             switch (res_move) {
                 case success:
-                    ui->SetMark(rowi, coli, *plr[curr_plr_i]);
+                    PlaceMark(cell, static_cast<player_i>(curr_plr_i));
+                    if (curr_plr_i == man) { redo_count = 0; }
                     run = false;
                     break;
+                case undo:
+                case redo:
+                    /* A pair of plies: the same player moves next */
+                    if (res_move == undo ? TakeBack() 
+                                         : Replay(move, swtch ? move : move + 1)) {
+                        move += res_move == undo ? -1 : 1;
+                        i += res_move == undo ? -2 : 2;
+                        ui->Clear(); 
+                        ui->Print(ConsoleUI::game_time, plr[curr_plr_i]);
+                    }
+                    else {
+                        ui->Clear(); 
+                        ui->Print(ConsoleUI::input_error, plr[curr_plr_i]);
+                    }
+                    break;
+                case hint:
+                    ui->Clear(); 
+                    ui->Print(ShowHint() ? ConsoleUI::game_time 
+                                         : ConsoleUI::input_error, 
+                              plr[curr_plr_i]);
+                    break;
+                case flag_fall:
+                    clock->Stop();
+                    ShowClock(false);
+                    RecordLine(move, "out of time", 
+                               static_cast<player_i>(curr_plr_i));
+                    ui->Clear();
+                    ui->Print(ConsoleUI::game_over, plr[!curr_plr_i]);
+                    if (broadcast) { 
+                        broadcast->Panel(ConsoleUI::game_over, !curr_plr_i); 
+                    }
+                    return quit;
                 case quit: return quit;
                 case restart: 
                     ui->Clear(); 
@@ -89,18 +179,33 @@ Game::pmove_t Game::Start()
                     ui->Clear(); 
                     ui->Print(ConsoleUI::range_error, plr[curr_plr_i]);
                     break;
+                case illegal_move:
+                    ui->Clear(); 
+                    ui->Print(ConsoleUI::rule_error, plr[curr_plr_i]);
+                    break;
+                case redraw:
+                    ui->Clear(); 
+                    ui->Print(ConsoleUI::game_time, plr[curr_plr_i]);
+                    break;
             }
         }
 
         ui->Clear();
+        if (clock) { ShowClock(false); }
 
-        int cgo_res = CheckGameOver(static_cast<player_i>(curr_plr_i));
+        int cgo_res = CheckGameOver();
         if (cgo_res == win) {
             ui->Print(ConsoleUI::game_over, plr[curr_plr_i]);
+            if (broadcast) { 
+                broadcast->Panel(ConsoleUI::game_over, curr_plr_i); 
+            }
             return quit;
         }
         else if (cgo_res == draw) {
             ui->Print(ConsoleUI::game_over);
+            if (broadcast) { 
+                broadcast->Panel(ConsoleUI::game_over, Broadcast::no_player); 
+            }
             return quit;
         }
     }
@@ -110,6 +215,17 @@ Game::pmove_t Game::Start()
 
 void Game::Reset()
 {
+    variant->Clear();
+    redo_count = 0;
+    if (clock) { clock->Reset(); }
+
+    if (batch) {
+        /* Scripted games only need a clean field */
+        ui->ClearField();
+        ui->DeleteAllMove();
+        return;
+    }
+
     delete plr[man];
     delete plr[bot];
     delete ui;
@@ -118,168 +234,465 @@ void Game::Reset()
     passwd *pw = getpwuid(geteuid());
     plr[man] = pw ? new Player(pw->pw_name, 'X') : new Player("Player", 'X');
 
-    plr[bot] = new Bot("><[O_O]><", 'O');
-    ui = new ConsoleUI();
+    plr[bot] = new Player("><[O_O]><", 'O');
+    ui = CreateUI();
     terminal = new Terminal();
 }
 
+ConsoleUI *Game::CreateUI() const
+{
+    ConsoleUI *res = new ConsoleUI(variant->GetRows(), variant->GetCols(), 
+                                   variant->GetTitle(), variant->GetBlockRows(),
+                                   variant->GetBlockCols());
+
+    res->SetBlockLabel(variant->GetBlockLabel());
+    res->SetMoveFormat(variant->GetMoveFormat());
+    res->SetSink(out);
+    return res;
+}
+
+void Game::SetClock(const char *spec)
+{
+    delete clock;
+    clock = 0;
+
+    clock = new MoveClock(spec);
+    reader->SetTimer(clock->GetFd());
+}
+
+void Game::Publish(const char *name)
+{
+    delete broadcast;
+    broadcast = 0;
+
+    broadcast = new Broadcast(name, *variant);
+    broadcast->SetPlayers(*plr[man], *plr[bot]);
+}
+
+void Game::RecordMove(int move_count, int cell, player_i plr_i) const
+{
+    char move[16];
+
+    variant->FormatMove(cell, move, sizeof(move));
+    RecordLine(move_count, move, plr_i);
+}
+
+void Game::RecordLine(int move_count, const char *text, player_i plr_i) const
+{
+    enum color { red = 31, blue = 34};
+    char line_buff[80];
+
+    snprintf(line_buff, sizeof(line_buff), "\033[%dm%d%c\033[0m %s",
+             plr_i ? red : blue, move_count, prompt, text);
+    ui->AddMove(line_buff, sizeof(line_buff));
+    if (broadcast) { broadcast->Line(move_count, plr_i, text); }
+}
+
+void Game::RebuildHistory() const
+{
+    char buff[16];
+    int count = variant->GetMoveCount();
+    /* Older lines would fall out of the history anyway */
+    int first = count < Broadcast::history_size 
+              ? 0 : count - Broadcast::history_size;
+
+    ui->DeleteAllMove();
+    if (broadcast) { broadcast->ClearLines(); }
+    if (first == 0) {
+        snprintf(buff, sizeof(buff), "0%c START", prompt);
+        ui->AddMove(buff, sizeof(buff));
+        if (broadcast) { broadcast->Line(0, Broadcast::no_player, "START"); }
+    }
+
+    for (int i = first; i < count; i++) {
+        char move[16];
+        /* The man is to move, so the last ply is the bot's */
+        player_i plr_i = (count - 1 - i) % 2 ? man : bot;
+
+        variant->FormatMove(variant->GetMove(i), move, sizeof(move));
+        RecordLine(i / 2 + 1, move, plr_i);
+    }
+}
+
+void Game::ShowClock(bool refresh) const
+{
+    char line[64], left[player_count][16];
+    int run = clock->GetRunning();
+
+    for (int i = 0; i < player_count; i++) {
+        MoveClock::Format(clock->GetLeft(static_cast<player_i>(i)), 
+                          left[i], sizeof(left[i]));
+    }
+
+    /* The running side is in brackets, like the last mark */
+    snprintf(line, sizeof(line), "%c%c %s%c  %c%c %s%c", 
+             run == man ? '[' : ' ', plr[man]->GetMark(), left[man], 
+             run == man ? ']' : ' ',
+             run == bot ? '[' : ' ', plr[bot]->GetMark(), left[bot], 
+             run == bot ? ']' : ' ');
+    ui->SetClock(line);
+    if (refresh) { ui->RefreshClock(); }
+}
+
+bool Game::TakeBack()
+{
+    int rowi, coli, last;
+
+    /* The man is to move: the last two moves are the bot's and the man's */
+    if (variant->GetMoveCount() < 2) { return false; }
+
+    for (int n = 0; n < 2; n++) {
+        int cell = variant->GetLastMove();
+
+        variant->Unmake();
+        variant->ToGrid(cell, rowi, coli);
+        ui->ClearMark(rowi, coli);
+        redo_cells[redo_count++] = cell;
+        if (broadcast) { broadcast->Unmark(rowi, coli); }
+    }
+
+    RebuildHistory();
+
+    /* The previous move of the bot is the last mark again */
+    if ((last = variant->GetLastMove()) != -1) {
+        variant->ToGrid(last, rowi, coli);
+        ui->SetMark(rowi, coli, *plr[bot]);
+        if (broadcast) { broadcast->Mark(rowi, coli, bot); }
+    }
+
+    return true;
+}
+
+bool Game::Replay(int move_count, int bot_move_count)
+{
+    if (redo_count < 2) { return false; }
+
+    int cell = redo_cells[--redo_count];
+    PlaceMark(cell, man);
+    RecordMove(move_count, cell, man);
+
+    cell = redo_cells[--redo_count];
+    PlaceMark(cell, bot);
+    RecordMove(bot_move_count, cell, bot);
+
+    return true;
+}
+
+bool Game::ShowHint()
+{
+    int cells = variant->GetRows() * variant->GetCols();
+    char *hints = new char[cells];
+    bool res = variant->Analyze(hints, hint_movetime);
+
+    for (int cell = 0; res && cell < cells; cell++) {
+        int rowi, coli;
+
+        if (!hints[cell]) { continue; }
+        variant->ToGrid(cell, rowi, coli);
+        ui->SetOverlay(rowi, coli, hints[cell]);
+    }
+
+    delete[] hints;
+    return res;
+}
+
+void Game::PlaceMark(int cell, player_i plr_i)
+{
+    int rowi, coli;
+
+    variant->Make(cell);
+    variant->ToGrid(cell, rowi, coli);
+    ui->SetMark(rowi, coli, *plr[plr_i]);
+    if (broadcast) { broadcast->Mark(rowi, coli, plr_i); }
+}
+
 const ConsoleUI &Game::GetUI() const
 {
     return *ui;
 }
 
-player_i Game::Intro() const
+player_i Game::Intro()
 {
     char buff[80];
     player_i first_plr_indx;
-    int rnd;
 
-    srand(time(0));
-    rnd = rand();
-    first_plr_indx = rnd % 2 ? man : bot;
+    first_plr_indx = rng.Below(2) ? man : bot;
 
     ui->Print(ConsoleUI::info, plr[first_plr_indx]);
+    if (broadcast) {
+        broadcast->Reset();
+        broadcast->Panel(ConsoleUI::info, first_plr_indx);
+    }
 
-    printf("%c PRESS ANY TO START...", prompt);
-    getc(stdin);
-    fputs("\r\033[2K", stdout);
-    fflush(stdout);
+    out->Print("%c PRESS ANY TO START...", prompt);
+    out->Flush();
+
+    /* Bypass stdio, the rest of the input belongs to Game::reader */
+    char key;
+    {
+        StatTimer timer(Stats::input);
+        read(STDIN_FILENO, &key, 1);
+    }
+    out->Puts("\r\033[2K");
+    out->Flush();
 
     snprintf(buff, sizeof(buff), "0%c START", prompt);
     ui->AddMove(buff, sizeof(buff));
+    if (broadcast) { broadcast->Line(0, Broadcast::no_player, "START"); }
 
     ui->Clear();
 
     return first_plr_indx;
 }
 
-Game::pmove_t Game::ProcessPlayerMove(int move_count, int &rowi, 
-                                int &coli, player_i plr_i ) const
+Game::pmove_t Game::ProcessPlayerMove(int move_count, int &cell, 
+                                      player_i plr_i) const
 {
+    TraceSpan span("Game::ProcessPlayerMove");
     enum color { red = 31, blue = 34};
 
-    char line_buff[80];
-    char input_buff[10];
+    char input_buff[16];
+    const char *input;
     color clr = plr_i ? red : blue;
 
-    memset(line_buff, 0, sizeof(line_buff));
     memset(input_buff, 0, sizeof(input_buff));
 
-    printf("\033[%dm%d%c\033[0m ", clr, move_count, prompt);
-    fflush(stdout);
+    out->Print("\033[%dm%d%c\033[0m ", clr, move_count, prompt);
+    out->Flush();
 
-    if (plr_i == bot) { BotHandle(rowi, coli, input_buff, sizeof(input_buff)); }
-    else { read(STDIN_FILENO, input_buff, sizeof(input_buff)); }
+    if (plr_i == bot) { 
+        if (!BotHandle(input_buff, sizeof(input_buff))) {
+            out->Puts("\r\033[2K");
+            return flag_fall;
+        }
+        input = input_buff;
+    }
+    else { 
+        {
+            StatTimer timer(Stats::input);
+            input = reader->ReadLine();
+
+            /* Woken up by the clock: the shown time changed or ran out */
+            while (!input && reader->IsInterrupted()) {
+                if (!clock->Wake()) {
+                    out->Puts("\r\033[2K");
+                    return flag_fall;
+                }
+                ShowClock(true);
+                input = reader->ReadLine();
+            }
+        }
+        if (!input) {
+            out->Putc('\n');
+            return quit;
+        }
 
-    char *p = input_buff;
-    while ((p = strchr(p, '\n')) != 0) {
-        fputs("\033[2K\033[1A", stdout);
-        p++;
+        /* The "\n" echoed by the terminal */
+        out->Puts("\033[2K\033[1A");
     }
-    fputc('\n', stdout);
+    out->Putc('\n');
 
-    if (strcmp("quit", input_buff) == 0) { return quit; }
-    if (strcmp("rest", input_buff) == 0) { 
-        fputs("\033[1A", stdout);
+    pmove_t res = ParseMove(input, cell);
+    if (res == quit) { return quit; }
+    if (res == restart) { 
+        out->Puts("\033[1A");
         return restart;
     }
 
-    fputs("\r\033[2K\033[1A", stdout);
-    fflush(stdout);
+    out->Puts("\r\033[2K\033[1A");
+    out->Flush();
 
-    int res_sscanf = sscanf(input_buff, "%d %d", &rowi, &coli);
-    if (res_sscanf != 2) { return invalid_input; }
-    char mark;
-    if (ui->IsBusy(rowi, coli, mark)) {
-        if (mark != '\0') { return cell_is_busy; }
-        else { return out_of_range; }
-    }
+    if (res != success) { return res; }
+    if (clock && !clock->Stop()) { return flag_fall; }
 
-    snprintf(line_buff, sizeof(line_buff), "\033[%dm%d%c\033[0m %d %d",
-             clr, move_count, prompt, rowi, coli);
-    ui->AddMove(line_buff, sizeof(line_buff));
+    RecordMove(move_count, cell, plr_i);
 
     return success;
 }
 
-Game::game_over_stat Game::CheckGameOver(player_i curr_plr_i)
+Game::pmove_t Game::ParseMove(const char *input, int &cell) const
 {
-	int count, has_free_cells = 0;
-	char curr_mark = plr[curr_plr_i]->GetMark();
-    char mark;
-
-	/* Check by rows */
-	for(int i = 0; i < ConsoleUI::row_count; i++) {
-		count = 0;
-		for(int j = 0; j < ConsoleUI::col_count; j++) {
-			if(ui->IsBusy(i, j, mark)) {
-                if (mark == curr_mark) { count++; }
-            }
-            else { has_free_cells = 1; }
-			if(count == 3) { return win; }
-		}
-	}
-
-	/* Check by columns */
-	for(int i = 0; i < ConsoleUI::row_count; i++) {
-		count = 0;
-		for(int j = 0; j < ConsoleUI::col_count; j++) {
-			if(ui->IsBusy(j, i, mark)) {
-                if (mark == curr_mark) { count++; }
+    if (strcmp("quit", input) == 0) { return quit; }
+    if (strcmp("rest", input) == 0) { return restart; }
+    if (!batch && strcmp("undo", input) == 0) { return undo; }
+    if (!batch && strcmp("redo", input) == 0) { return redo; }
+    if (!batch && strcmp("hint", input) == 0) { return hint; }
+
+    if (ui->IsPaged()) {
+        if (strcmp("up", input) == 0) { return ui->Scroll(-1) ? redraw : invalid_input; }
+        if (strcmp("down", input) == 0) { return ui->Scroll(1) ? redraw : invalid_input; }
+    }
+
+    switch (variant->ParseMove(input, cell)) {
+        case Variant::valid: return success;
+        case Variant::busy: return cell_is_busy;
+        case Variant::out_of_range: return out_of_range;
+        case Variant::illegal: return illegal_move;
+        default: return invalid_input;
+    }
+}
+
+/**
+ * @brief Joins the coordinates of a move for the batch report.
+ * 
+ * "1 1" becomes "11"; if any coordinate has two digits, they are
+ * separated by commas instead: "14 3" becomes "14,3".
+ */
+static void CompactMove(char *move)
+{
+    bool single = true;
+    size_t n = 0;
+
+    for (const char *w = move; *w; w++) {
+        if (*w != ' ' && w[1] != ' ' && w[1] != '\0') { single = false; }
+    }
+
+    for (const char *w = move; *w; w++) {
+        if (*w != ' ') { move[n++] = *w; }
+        else if (!single) { move[n++] = ','; }
+    }
+    move[n] = '\0';
+}
+
+Game::pmove_t Game::StartBatch()
+{
+    TraceSpan span("Game::StartBatch");
+
+    /* "X14,14 " per cell of the largest variant */
+    char moves[4096];
+    char move[16];
+    size_t moves_len = 0;
+    int cell, curr_plr_i;
+    const char *cmd;
+
+    /* Nothing left to play: only the summary remains */
+    cmd = NextCommand();
+    if (!cmd) {
+        BatchSummary();
+        return quit;
+    }
+
+    moves[0] = '\0';
+    curr_plr_i = rng.Below(2) ? man : bot;
+
+    for (;; curr_plr_i = !curr_plr_i) {
+        if (curr_plr_i == bot) { cell = variant->BotMove(); }
+        else {
+            for (;;) {
+                if (!cmd) { cmd = NextCommand(); }
+                if (!cmd) { 
+                    BatchReport('-', moves);
+                    return restart; 
+                }
+
+                pmove_t res = ParseMove(cmd, cell);
+                if (res == success) { 
+                    cmd = 0;
+                    break; 
+                }
+                if (res == quit || res == restart) {
+                    BatchReport('-', moves);
+                    if (res == quit) { BatchSummary(); }
+                    return res;
+                }
+                if (res == redraw) { 
+                    cmd = 0;
+                    continue;
+                }
+
+                fprintf(stderr, "game %d: %s: \"%s\"\n", batch_games + 1,
+                        res == invalid_input ? "invalid input" :
+                        res == cell_is_busy ? "cell is busy" : 
+                        res == illegal_move ? "not allowed" :
+                        "out of range", cmd);
+                cmd = 0;
             }
-            else { has_free_cells = 1; }
-			if(count == 3) { return win; }
-		}
-	}
-
-	/* Main diagonal */
-	for(int i = 0, count = 0; i < ConsoleUI::row_count; i++) {
-        if(ui->IsBusy(i, i, mark)) {
-            if (mark == curr_mark) { count++; }
         }
-        else { has_free_cells = 1; }
-        if(count == 3) { return win; }
-	}
-
-	/* Secondary diagonal */
-	for(int i = 0, count = 0; i < ConsoleUI::row_count; i++) {
-        if(ui->IsBusy(i, 2 - i, mark)) {
-            if (mark == curr_mark) { count++; }
-        }
-        else { has_free_cells = 1; }
-        if(count == 3) { return win; }
-	}
 
-	/* Checking a draw */
-	if(!has_free_cells) { return draw; }
+        PlaceMark(cell, static_cast<player_i>(curr_plr_i));
+
+        variant->FormatMove(cell, move, sizeof(move));
+        CompactMove(move);
+        moves_len += snprintf(moves + moves_len, sizeof(moves) - moves_len,
+                              "%s%c%s", moves_len ? " " : "", 
+                              plr[curr_plr_i]->GetMark(), move);
 
-	return absent; 
+        int cgo_res = CheckGameOver();
+        if (cgo_res == win) {
+            BatchReport(plr[curr_plr_i]->GetMark(), moves);
+            return restart;
+        }
+        else if (cgo_res == draw) {
+            BatchReport('D', moves);
+            return restart;
+        }
+    }
 }
 
-void Game::BotHandle(int &rowi, int &coli, char *buff, size_t size) const
+const char *Game::NextCommand()
 {
-    if (size < 4) { return; }
+    StatTimer timer(Stats::input);
+    const char *line;
 
-    static_cast<Bot *>(plr[bot])->Move(GetUI(), rowi, coli);
+    while ((line = reader->ReadLine()) != 0) {
+        if (line[0] != '\0' && line[0] != '#') { break; }
+    }
 
-    terminal->DisableEcho();
+    return line;
+}
 
-    sleep(1);
-    printf("%d", rowi);
-    fflush(stdout);
+void Game::BatchReport(char result, const char *moves)
+{
+    batch_games++;
+    batch_stat[static_cast<unsigned char>(result) & 127]++;
 
-    sleep(1);
-    printf(" %d", coli);
+    printf("%d %c %s\n", batch_games, result, moves);
+}
+
+void Game::BatchSummary() const
+{
+    printf("# games %d, X %d, O %d, draw %d, abandoned %d\n", 
+           batch_games, batch_stat['X'], batch_stat['O'], 
+           batch_stat['D'], batch_stat['-']);
     fflush(stdout);
+}
+
+Game::game_over_stat Game::CheckGameOver() const
+{
+    switch (variant->GetResult()) {
+        case Variant::won: return win;
+        case Variant::drawn: return draw;
+        default: return absent;
+    }
+}
+
+bool Game::BotHandle(char *buff, size_t size) const
+{
+    TraceSpan span("Game::BotHandle");
+
+    if (size < 4) { return true; }
+
+    variant->FormatMove(variant->BotMove(), buff, size);
+    if (clock && !clock->Stop()) { return false; }
 
-    sleep(1);
+    {
+        Terminal::Scope quiet(*terminal, Terminal::canon);
 
-    terminal->EnableEcho();
+        /* Typed word by word */
+        for (const char *w = buff; *w; w++) {
+            if (w == buff || *w == ' ') {
+                out->Flush();
+                sleep(1);
+            }
+            out->Putc(*w);
+        }
+        out->Flush();
+
+        sleep(1);
+    }
 
     tcflush(STDIN_FILENO, TCIFLUSH);
+    reader->Discard();
 
-    buff[0] = 48 + rowi;
-    buff[1] = ' ';
-    buff[2] = 48 + coli;
-    buff[3] = 0;
+    return true;
 }
@@ -22,9 +22,13 @@
 #define GAME_H_SENTRY
 
 #include "../player/player.h"
-#include "../bot/bot.h"
+#include "../variant/variant.h"
 #include "../console_ui/console_ui.h"
 #include "../terminal/terminal.h"
+#include "../line_reader/line_reader.h"
+#include "../move_clock/move_clock.h"
+#include "../broadcast/broadcast.h"
+#include "../rng/rng.h"
 #include "../player_i.h"
 
 /**
@@ -46,7 +50,13 @@ public:
         cell_is_busy    = 2,
         out_of_range    = 3,
         quit            = 4, /**< Useful for Game::Start */
-        restart         = 5  /**< Useful for Game::Start */
+        restart         = 5, /**< Useful for Game::Start */
+        redraw          = 6, /**< The page of the field has moved */
+        illegal_move    = 7, /**< Free cell the rules forbid */
+        undo            = 8, /**< Take back the last own move */
+        redo            = 9, /**< Make the taken back moves again */
+        hint            = 10,/**< Show the values of the free cells */
+        flag_fall       = 11 /**< The player is out of time */
     } pmove_t;
 
 private:
@@ -60,14 +70,66 @@ private:
      */
     enum game_over_stat { win, draw, absent };
 
+    /** Milliseconds the analysis of a hint may take */
+    enum { hint_movetime = 200 };
+
     Player *plr[player_count];  /**< The participants of the game */
+    Variant *variant;           /**< Rules, position and the bot */
     ConsoleUI *ui;              /**< Interface rendering */
     Terminal *terminal;         /**< Setting up a terminal session */
+    LineReader *reader;         /**< Player's input split into lines */
+    MoveClock *clock;           /**< Time control, NULL if none */
+    OutputSink *out;            /**< Where the session is drawn */
+    Broadcast *broadcast;       /**< Spectators, NULL if not published */
+    Rng rng;                    /**< Choice of the first player */
 
     const char prompt;  /**< A symbol indicating an input prompt */
 
+    /**
+     * @brief Non-interactive mode (see Game::Game(int)).
+     * 
+     * No terminal setup, no rendering and no delays:
+     * the moves of the man are taken from the script.
+     */
+    const bool batch;
+
+    /**
+     * @brief Counters of the scripted games.
+     * 
+     * Index: Player::GetMark result of the winner ('X' or 'O'),
+     *        'D' for draws and '-' for abandoned games.
+     */
+    int batch_stat[128];
+    int batch_games;            /**< Number of scripted games */
+
+    /** Taken back cells, the next one to make again is on top */
+    int *redo_cells;
+    int redo_count;
+
 public:
-    Game();
+    /**
+     * @param variant_name See Variant::Create.
+     * 
+     * @throws const char * if the variant is unknown.
+     */
+    explicit Game(const char *variant_name = "classic");
+
+    /**
+     * @brief Creates a game in the non-interactive (batch) mode.
+     * 
+     * Each line of the script is a command: "row col", "rest" or "quit".
+     * Empty lines and lines starting with '#' are skipped.
+     * A game is over on a win or a draw, after which Game::Start
+     * returns restart and the next game takes the following lines.
+     * The result of every game is printed as a single line:
+     * "<number> <X|O|D|-> <moves>", e.g. "1 X X11 O00 X22 O02 X01 O21 X10".
+     * 
+     * @param script_fd Source of the script (pipe, file or terminal).
+     * @param variant_name See Variant::Create.
+     * 
+     * @throws const char * if the variant is unknown.
+     */
+    explicit Game(int script_fd, const char *variant_name = "classic");
     ~Game();
 
     /**
@@ -85,6 +147,24 @@ public:
      */
     void Reset();
 
+    /**
+     * @brief Plays with a time control, the out of time player loses.
+     * 
+     * Only the thinking of the bot is on its clock, not the typing.
+     * 
+     * @param spec See MoveClock::MoveClock.
+     * 
+     * @throws const char * if the spec is wrong.
+     */
+    void SetClock(const char *spec);
+
+    /**
+     * @brief Publishes the games for spectators ("ttt watch NAME").
+     * 
+     * @throws const char * if the game can't be published.
+     */
+    void Publish(const char *name);
+
     const ConsoleUI &GetUI() const;
 
 private:
@@ -98,7 +178,7 @@ private:
      * 
      * @return player_i Index of the first player.
      */
-    player_i Intro() const;
+    player_i Intro();
 
     /**
      * @brief Processing player input.
@@ -107,35 +187,145 @@ private:
      * If the input is successful, the prompt string is saved in ConsoleUI.
      *
      * @param move_count Current move number (for display).
-     * @param[out] rowi  Selected row (if input valid).
-     * @param[out] coli  Selected column (if input valid).
+     * @param[out] cell Selected cell of the variant (if input valid).
      * @param plr_i Index of the current player.
      * 
      * @return pmove_t Input result: success, errors, or commands.
      */
-    pmove_t ProcessPlayerMove(int move_count, int &rowi, 
-                              int &coli, player_i plr_i) const;
+    pmove_t ProcessPlayerMove(int move_count, int &cell, player_i plr_i) const;
+
+    /**
+     * @brief Interprets a single line of input.
+     * 
+     * Besides moves and commands, "up" and "down" scroll a paged field,
+     * "undo" and "redo" take moves back and "hint" analyzes the position
+     * (not in the batch mode).
+     * 
+     * @param input Null-terminated line without "\n".
+     * @param[out] cell Selected cell (if input valid).
+     * 
+     * @return pmove_t Input result: success, errors, or commands.
+     */
+    pmove_t ParseMove(const char *input, int &cell) const;
+
+    /**
+     * @brief Makes the move in the variant and shows it on the field.
+     */
+    void PlaceMark(int cell, player_i plr_i);
 
     /**
-     * @brief Checks if the game is over for current player
+     * @brief Adds the move to the history of the ConsoleUI.
      * 
-     * @param curr_plr_i Index of current player
-     * @return game_over_stat Game status: win, draw, or absent
+     * @param move_count Move number shown in the prompt.
      */
-    game_over_stat CheckGameOver(player_i curr_plr_i);
+    void RecordMove(int move_count, int cell, player_i plr_i) const;
+
+    /**
+     * @brief Adds a line after the colored move number to the history.
+     */
+    void RecordLine(int move_count, const char *text, player_i plr_i) const;
+
+    /**
+     * @brief Fills the history of the ConsoleUI and of the spectators
+     *        from the moves of the variant.
+     * 
+     * The man must be to move. The history keeps only the last lines,
+     * so a move taken back can't just drop the last one.
+     */
+    void RebuildHistory() const;
+
+    /**
+     * @brief Puts the times of the clock into the panel.
+     * 
+     * @param refresh Rewrite the panel line on the screen right away.
+     */
+    void ShowClock(bool refresh) const;
+
+    /**
+     * @brief Takes back the reply of the bot and the move of the man.
+     * 
+     * Both are unmade in the variant and cleared on the field, the
+     * history is rebuilt; their cells go on the redo stack.
+     * 
+     * @return false if the man has no move to take back.
+     */
+    bool TakeBack();
+
+    /**
+     * @brief Makes the last taken back pair of moves again.
+     * 
+     * @param move_count Number of the man's move.
+     * @param bot_move_count Number of the bot's reply.
+     * 
+     * @return false if nothing was taken back.
+     */
+    bool Replay(int move_count, int bot_move_count);
+
+    /**
+     * @brief Puts the values of the moves of the man on the field.
+     * 
+     * They stay until the next change of the field.
+     * 
+     * @return false if the variant can't analyze the position.
+     */
+    bool ShowHint();
+
+    /**
+     * @brief A new ConsoleUI of the size of the variant.
+     */
+    ConsoleUI *CreateUI() const;
+
+    /**
+     * @brief The game loop of the non-interactive mode.
+     * 
+     * @return pmove_t::quit If the script is over or says "quit".
+     * @return pmove_t::restart If the next game should be played.
+     */
+    pmove_t StartBatch();
+
+    /**
+     * @brief Returns the next line of the script that is a command.
+     * 
+     * @return Null-terminated line, or NULL if the script is over.
+     */
+    const char *NextCommand();
+
+    /**
+     * @brief Prints the result line of a scripted game.
+     * 
+     * @param result Mark of the winner, 'D' for a draw, '-' if abandoned.
+     * @param moves Space separated moves of the game.
+     */
+    void BatchReport(char result, const char *moves);
+
+    /**
+     * @brief Prints the totals of the scripted games, at the end of
+     *        the script or on "quit".
+     */
+    void BatchSummary() const;
+
+    /**
+     * @brief Checks if the last move has ended the game.
+     * 
+     * @return game_over_stat Game status: win (of the player who has
+     *         moved), draw, or absent
+     */
+    game_over_stat CheckGameOver() const;
 
     /**
      * @brief Handles bot move generation and formats result into buffer.
      * 
-     * @param rowi Reference to store bot's chosen row coordinate.
-     * @param coli Reference to store bot's chosen column coordinate.
-     * @param buff Output buffer for formatted move string "row col\0".
+     * The move is typed out word by word, as if by the player.
+     * 
+     * @param buff Output buffer for the move in the input form, e.g. "1 1".
      * @param size Size of the output buffer (must be at least 4).
      * 
      * @note Terminal echo is temporarily disabled during coordinate display.
      * @note Input buffer is flushed after displaying coordinates.
+     * 
+     * @return false if the bot ran out of time, nothing is typed then.
      */  
-    void BotHandle(int &rowi, int &coli, char *buff, size_t size) const;
+    bool BotHandle(char *buff, size_t size) const;
 };
 
 #endif /* GAME_H_SENTRY */
@@ -0,0 +1,224 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "gomoku.h"
+
+uint8_t Gomoku::pattern[2][1 << 18];
+pthread_once_t Gomoku::pattern_once = PTHREAD_ONCE_INIT;
+
+Gomoku::Gomoku()
+{
+    /* Steps of the rows, columns, diagonals and antidiagonals */
+    static const int drow[dir_count] = { 0, 1, 1,  1 };
+    static const int dcol[dir_count] = { 1, 0, 1, -1 };
+
+    pthread_once(&pattern_once, BuildPatterns);
+
+    memset(line_cell, -1, sizeof(line_cell));
+
+    for (int d = 0; d < dir_count; d++) {
+        int count = 0;
+
+        /* Every line starts at a cell whose predecessor is off the board */
+        for (int r = 0; r < size; r++) {
+            for (int c = 0; c < size; c++) {
+                int pr = r - drow[d], pc = c - dcol[d];
+                if (pr >= 0 && pr < size && pc >= 0 && pc < size) { continue; }
+
+                for (int i = 0, rr = r, cc = c; 
+                     rr >= 0 && rr < size && cc >= 0 && cc < size; 
+                     i++, rr += drow[d], cc += dcol[d]) 
+                {
+                    int cell = rr * size + cc;
+                    line_of[d][cell] = count;
+                    pos_of[d][cell] = i;
+                    line_cell[d][count][i] = cell;
+                }
+                count++;
+            }
+        }
+    }
+
+    Clear();
+}
+
+void Gomoku::Clear()
+{
+    memset(stone, 0, sizeof(stone));
+    memset(five_at, 0, sizeof(five_at));
+    move_count = 0;
+
+    /* Walls everywhere but the cells of the line */
+    for (int d = 0; d < dir_count; d++) {
+        for (int l = 0; l < line_max; l++) {
+            line[d][l] = ~uint64_t(0);
+            for (int i = 0; i < size && line_cell[d][l][i] != -1; i++) {
+                line[d][l] &= ~(uint64_t(3) << 2 * (i + reach));
+            }
+        }
+    }
+
+    for (int d = 0; d < dir_count; d++) {
+        for (int cell = 0; cell < cell_count; cell++) { Classify(d, cell); }
+    }
+}
+
+Gomoku::threat Gomoku::GetMaxThreat(int side, int cell) const
+{
+    int best = none;
+
+    for (int d = 0; d < dir_count; d++) {
+        if (threat_at[side][d][cell] > best) { best = threat_at[side][d][cell]; }
+    }
+
+    return static_cast<threat>(best);
+}
+
+void Gomoku::Make(int cell)
+{
+    int side = GetTurn();
+
+    five_at[move_count] = GetMaxThreat(side, cell) == five;
+    history[move_count++] = cell;
+
+    stone[cell] = side + 1;
+    Update(cell, side + 1);
+}
+
+void Gomoku::Unmake()
+{
+    int cell = history[--move_count];
+
+    five_at[move_count] = false;
+    stone[cell] = 0;
+    Update(cell, 0);
+}
+
+void Gomoku::Update(int cell, int value)
+{
+    for (int d = 0; d < dir_count; d++) {
+        int l = line_of[d][cell], p = pos_of[d][cell];
+        int shift = 2 * (p + reach);
+
+        line[d][l] = (line[d][l] & ~(uint64_t(3) << shift)) 
+                   | uint64_t(value) << shift;
+
+        for (int q = p - reach; q <= p + reach; q++) {
+            if (q < 0 || q >= size) { continue; }
+
+            int e = line_cell[d][l][q];
+            if (e != -1 && stone[e] == 0) { Classify(d, e); }
+        }
+    }
+}
+
+void Gomoku::Classify(int dir, int cell)
+{
+    uint32_t slice = line[dir][line_of[dir][cell]] >> 2 * pos_of[dir][cell] 
+                   & 0x3ffff;
+
+    threat_at[0][dir][cell] = pattern[0][slice];
+    threat_at[1][dir][cell] = pattern[1][slice];
+}
+
+/* Length of the own run through the cell covers the center */
+static bool FiveThroughCenter(const int *w, int own, int i)
+{
+    int a = i, b = i;
+
+    while (a > 0 && w[a - 1] == own) { a--; }
+    while (b < 8 && w[b + 1] == own) { b++; }
+
+    return a <= Gomoku::reach && b >= Gomoku::reach && b - a + 1 >= 5;
+}
+
+/* Free cells that would complete a five through the center */
+static int FiveCells(int *w, int own)
+{
+    int count = 0;
+
+    for (int e = 0; e < 9; e++) {
+        if (w[e] != 0) { continue; }
+
+        w[e] = own;
+        count += FiveThroughCenter(w, own, e);
+        w[e] = 0;
+    }
+
+    return count;
+}
+
+Gomoku::threat Gomoku::SliceThreat(const int *slice, int own)
+{
+    int w[9];
+    int best = none;
+
+    memcpy(w, slice, sizeof(w));
+    w[reach] = own;
+
+    if (FiveThroughCenter(w, own, reach)) { return five; }
+
+    int fives = FiveCells(w, own);
+    if (fives >= 2) { return open_four; }
+    if (fives == 1) { return four; }
+
+    for (int e = 0; e < 9; e++) {
+        if (w[e] != 0) { continue; }
+
+        w[e] = own;
+        fives = FiveCells(w, own);
+        w[e] = 0;
+
+        if (fives >= 2) { return open_three; }
+        if (fives == 1) { best = three; }
+    }
+    if (best == three) { return three; }
+
+    /* Five-cell segments with the center and no other stones or walls */
+    for (int a = 0; a <= reach; a++) {
+        int count = 0;
+        bool open = true;
+
+        for (int i = a; i < a + 5; i++) {
+            if (w[i] == own) { count++; }
+            else if (w[i] != 0) { open = false; }
+        }
+
+        if (open && count >= 2) { return two; }
+        if (open) { best = one; }
+    }
+
+    return static_cast<threat>(best);
+}
+
+void Gomoku::BuildPatterns()
+{
+    for (uint32_t slice = 0; slice < (1 << 18); slice++) {
+        int w[9];
+
+        for (int i = 0; i < 9; i++) { w[i] = slice >> 2 * i & 3; }
+        if (w[reach] != 0) { continue; }
+
+        pattern[0][slice] = SliceThreat(w, 1);
+        pattern[1][slice] = SliceThreat(w, 2);
+    }
+}
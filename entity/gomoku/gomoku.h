@@ -0,0 +1,145 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GOMOKU_H_SENTRY
+#define GOMOKU_H_SENTRY
+
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @class Gomoku
+ * @brief 15x15 five-in-a-row position with incremental threat tables.
+ * 
+ * Each row, column and diagonal is a word of 2-bit cells (0 free, 1 and
+ * 2 the stones of sides 0 and 1, 3 off the board) padded by 4 walls at
+ * both ends. The 9 cells around a free cell along a direction are an
+ * 18-bit slice of that word, and a precomputed table tells what a stone
+ * put there would make (a five, a four, an open three...).
+ * 
+ * A move rewrites one cell in 4 words and reclassifies only the free
+ * cells within 4 steps of it on those lines, so the threat of any move
+ * is known without scanning the field.
+ */
+class Gomoku {
+public:
+    enum { 
+        size = 15, 
+        cell_count = size * size,
+        dir_count = 4,
+        reach = 4,                          /**< Cells on each side of a slice */
+        line_max = 2 * size - 1             /**< Lines of one direction */
+    };
+
+    /**
+     * @enum threat
+     * @brief What a stone makes along one line, weakest first.
+     * 
+     * @var one        A free five-cell segment with this stone.
+     * @var two        Such a segment with two own stones.
+     * @var three      One move from a four.
+     * @var open_three One move from an open four.
+     * @var four       One move from a five.
+     * @var open_four  Two different cells make a five.
+     * @var five       Five or more in a row.
+     */
+    enum threat { 
+        none, one, two, three, open_three, four, open_four, five, 
+        threat_count 
+    };
+
+private:
+    /** Threat of a slice by side, the center cell must be free */
+    static uint8_t pattern[2][1 << 18];
+    static pthread_once_t pattern_once;
+
+    uint64_t line[dir_count][line_max];
+    uint8_t line_of[dir_count][cell_count];
+    uint8_t pos_of[dir_count][cell_count];
+    int16_t line_cell[dir_count][line_max][size];   /**< -1 off the board */
+
+    uint8_t stone[cell_count];                      /**< 0 free, 1, 2 */
+    uint8_t threat_at[2][dir_count][cell_count];    /**< Of free cells */
+
+    int history[cell_count];
+    bool five_at[cell_count];       /**< By ply: the move made a five */
+    int move_count;
+
+public:
+    Gomoku();
+
+    void Clear();
+
+    int GetTurn() const { return move_count & 1; }
+    int GetMoveCount() const { return move_count; }
+    int GetLastMove() const 
+        { return move_count ? history[move_count - 1] : -1; }
+    int GetMove(int i) const { return history[i]; }
+
+    /** @return 0 if free, 1 or 2 for a stone of side 0 or 1 */
+    int GetStone(int cell) const { return stone[cell]; }
+    bool IsFree(int cell) const { return stone[cell] == 0; }
+    bool IsFull() const { return move_count == cell_count; }
+
+    /** @return The last move made five in a row */
+    bool IsWon() const { return move_count && five_at[move_count - 1]; }
+
+    /**
+     * @brief Threat of a stone of the side in a free cell along a direction.
+     */
+    threat GetThreat(int side, int dir, int cell) const
+        { return static_cast<threat>(threat_at[side][dir][cell]); }
+
+    /**
+     * @brief The strongest threat over all directions.
+     */
+    threat GetMaxThreat(int side, int cell) const;
+
+    /**
+     * @brief Places a stone of the side to move into a free cell.
+     */
+    void Make(int cell);
+
+    /**
+     * @brief Takes back the last move.
+     */
+    void Unmake();
+
+private:
+    Gomoku(Gomoku &g);
+    void operator=(Gomoku &g);
+
+    static void BuildPatterns();
+
+    /**
+     * @brief Threat of a stone of the side in the center of a slice.
+     */
+    static threat SliceThreat(const int *w, int own);
+
+    /**
+     * @brief Sets the cell in the words and reclassifies the free cells
+     *        around it.
+     */
+    void Update(int cell, int value);
+
+    void Classify(int dir, int cell);
+};
+
+#endif /* GOMOKU_H_SENTRY */
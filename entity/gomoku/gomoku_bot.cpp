@@ -0,0 +1,194 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gomoku_bot.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
+
+GomokuBot::GomokuBot()
+    : nodes(0)
+    , depth(0)
+    , deadline(0)
+    , aborted(false)
+{}
+
+int GomokuBot::Choose(Gomoku &game, long movetime)
+{
+    TraceSpan span("GomokuBot::Choose");
+    int me = game.GetTurn();
+    int move;
+
+    nodes = 0;
+    depth = 0;
+
+    if (game.IsFull()) { return -1; }
+    if (game.GetMoveCount() == 0) { return Gomoku::cell_count / 2; }
+
+    if ((move = FindFive(game, me)) != -1) { return move; }
+    if ((move = FindFive(game, !me)) != -1) { return move; }
+
+    deadline = Stats::Now() + movetime * 1000000ULL;
+    aborted = false;
+
+    for (int d = 1; d <= max_depth; d++) {
+        if (Attack(game, d, &move)) { return move; }
+        if (aborted) { break; }
+        depth = d;
+    }
+
+    return Heuristic(game);
+}
+
+int GomokuBot::FindFive(const Gomoku &game, int side)
+{
+    for (int cell = 0; cell < Gomoku::cell_count; cell++) {
+        if (game.IsFree(cell) && game.GetMaxThreat(side, cell) == Gomoku::five) {
+            return cell;
+        }
+    }
+
+    return -1;
+}
+
+bool GomokuBot::Attack(Gomoku &game, int depth, int *move)
+{
+    int att = game.GetTurn(), def = !att;
+    int fours[Gomoku::cell_count], threes[Gomoku::cell_count];
+    int four_count = 0, three_count = 0;
+    bool def_fours = false;
+    int five;
+
+    if ((++nodes & 255) == 0 && Stats::Now() > deadline) { aborted = true; }
+    if (aborted) { return false; }
+
+    if ((five = FindFive(game, att)) != -1) {
+        if (move) { *move = five; }
+        return true;
+    }
+
+    /* The defender wins first, or has to be answered */
+    if (depth == 0 || FindFive(game, def) != -1) { return false; }
+
+    for (int cell = 0; cell < Gomoku::cell_count; cell++) {
+        if (!game.IsFree(cell)) { continue; }
+
+        Gomoku::threat t = game.GetMaxThreat(att, cell);
+        if (t >= Gomoku::four) { fours[four_count++] = cell; }
+        else if (t == Gomoku::open_three) { threes[three_count++] = cell; }
+
+        if (game.GetMaxThreat(def, cell) >= Gomoku::four) { def_fours = true; }
+    }
+
+    /* A three gives the defender time for a four of its own */
+    if (def_fours) { three_count = 0; }
+
+    for (int i = 0; i < four_count + three_count; i++) {
+        int cell = i < four_count ? fours[i] : threes[i - four_count];
+        bool won = true;
+
+        game.Make(cell);
+
+        if (i < four_count) {
+            /* The only defence is the cell of the five */
+            int block = FindFive(game, att);
+
+            game.Make(block);
+            won = Attack(game, depth - 1, 0);
+            game.Unmake();
+        }
+        else {
+            /* Every cell where the attacker would make a four */
+            int replies = 0;
+
+            for (int r = 0; r < Gomoku::cell_count && won; r++) {
+                if (!game.IsFree(r) || game.GetMaxThreat(att, r) < Gomoku::four) {
+                    continue;
+                }
+
+                replies++;
+                game.Make(r);
+                won = Attack(game, depth - 1, 0);
+                game.Unmake();
+            }
+            if (replies == 0) { won = false; }
+        }
+
+        game.Unmake();
+
+        if (won && !aborted) {
+            if (move) { *move = cell; }
+            return true;
+        }
+        if (aborted) { return false; }
+    }
+
+    return false;
+}
+
+int GomokuBot::Heuristic(const Gomoku &game)
+{
+    static const int weight[Gomoku::threat_count] = {
+        0, 1, 10, 30, 500, 600, 20000, 100000
+    };
+    int me = game.GetTurn();
+    int best = -1, best_score = -1, ties = 0;
+
+    for (int cell = 0; cell < Gomoku::cell_count; cell++) {
+        if (!game.IsFree(cell)) { continue; }
+
+        /* Only cells next to the stones (within two steps) */
+        int r = cell / Gomoku::size, c = cell % Gomoku::size;
+        bool near = false;
+        for (int i = r - 2; i <= r + 2 && !near; i++) {
+            for (int j = c - 2; j <= c + 2 && !near; j++) {
+                if (i < 0 || i >= Gomoku::size || j < 0 || j >= Gomoku::size) {
+                    continue;
+                }
+                near = !game.IsFree(i * Gomoku::size + j);
+            }
+        }
+        if (!near) { continue; }
+
+        int own = 0, opp = 0, own_threats = 0, opp_threats = 0;
+        for (int d = 0; d < Gomoku::dir_count; d++) {
+            Gomoku::threat a = game.GetThreat(me, d, cell);
+            Gomoku::threat b = game.GetThreat(!me, d, cell);
+
+            own += weight[a];
+            opp += weight[b];
+            own_threats += a >= Gomoku::open_three;
+            opp_threats += b >= Gomoku::open_three;
+        }
+
+        /* Two threats at once can't be answered with one move */
+        int score = own + opp * 4 / 5;
+        if (own_threats >= 2) { score += 50000; }
+        if (opp_threats >= 2) { score += 40000; }
+
+        if (score > best_score) {
+            best_score = score;
+            best = cell;
+            ties = 1;
+        }
+        else if (score == best_score && rng.Below(++ties) == 0) { best = cell; }
+    }
+
+    return best;
+}
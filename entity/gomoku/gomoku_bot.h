@@ -0,0 +1,90 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GOMOKU_BOT_H_SENTRY
+#define GOMOKU_BOT_H_SENTRY
+
+#include <stdint.h>
+
+#include "gomoku.h"
+#include "../rng/rng.h"
+
+/**
+ * @class GomokuBot
+ * @brief Threat-space search for Gomoku.
+ * 
+ * The search only tries moves that make a four or an open three, so
+ * the defender has a few forced replies: the cell that blocks a four,
+ * or every cell where the attacker would get a four after a three.
+ * Iterative deepening on the number of attacker moves runs until a
+ * win is proven or the time is out, then a move is picked by the
+ * threat tables (own threats and blocks of the opponent's).
+ */
+class GomokuBot {
+private:
+    enum { max_depth = 16 };
+
+    Rng rng;
+    long long nodes;            /**< Of the last GomokuBot::Choose */
+    int depth;                  /**< Deepest completed iteration */
+    uint64_t deadline;          /**< Stats::Now time */
+    bool aborted;
+
+public:
+    GomokuBot();
+
+    /**
+     * @brief Chooses a move for the side to move.
+     * 
+     * @param game Position, restored before return.
+     * @param movetime Milliseconds for the threat-space search.
+     * 
+     * @return Selected cell, -1 if the field is full.
+     */
+    int Choose(Gomoku &game, long movetime);
+
+    long long GetNodes() const { return nodes; }
+    int GetDepth() const { return depth; }
+
+    void SetSeed(uint64_t seed) { rng.Seed(seed); }
+
+private:
+    GomokuBot(GomokuBot &b);
+    void operator=(GomokuBot &b);
+
+    /**
+     * @brief Proves a win of the side to move by continuous threats.
+     * 
+     * @param[out] move First move of the win (can be NULL).
+     */
+    bool Attack(Gomoku &game, int depth, int *move);
+
+    /**
+     * @return A cell where the side makes five, -1 if none.
+     */
+    static int FindFive(const Gomoku &game, int side);
+
+    /**
+     * @brief Best cell by own threats and threats of the opponent.
+     */
+    int Heuristic(const Gomoku &game);
+};
+
+#endif /* GOMOKU_BOT_H_SENTRY */
@@ -0,0 +1,254 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "learner.h"
+#include "../stats/stats.h"
+
+Learner::Learner(int argc, char **argv)
+    : size(3)
+    , k(0)
+    , episodes(1000000)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , alpha(0.25)
+    , epsilon(0.1)
+    , report_ms(1000)
+    , out_path("ttt.values")
+    , seed(Rng::GetDefaultSeed())
+    , board(0)
+    , table(0)
+    , solved(0)
+    , sample(0)
+    , sample_count(0)
+    , next(0)
+    , done(0)
+{
+    const char *resume = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--size") == 0) { size = atoi(val); }
+        else if (strcmp(argv[i - 1], "--k") == 0) { k = atoi(val); }
+        else if (strcmp(argv[i - 1], "--episodes") == 0) { episodes = atoll(val); }
+        else if (strcmp(argv[i - 1], "--threads") == 0) { threads = atoi(val); }
+        else if (strcmp(argv[i - 1], "--alpha") == 0) { alpha = atof(val); }
+        else if (strcmp(argv[i - 1], "--epsilon") == 0) { epsilon = atof(val); }
+        else if (strcmp(argv[i - 1], "--report") == 0) { report_ms = atol(val); }
+        else if (strcmp(argv[i - 1], "--out") == 0) { out_path = val; }
+        else if (strcmp(argv[i - 1], "--resume") == 0) { resume = val; }
+        else { throw "Unknown option"; }
+    }
+
+    if (k == 0) { k = size; }
+    if (size * size > ValueTable::max_cells) { throw "Board is too large"; }
+    if (episodes < 1 || report_ms < 1) { throw "Bad option value"; }
+    if (alpha <= 0 || alpha > 1 || epsilon < 0 || epsilon > 1) {
+        throw "Bad option value";
+    }
+    if (threads < 1) { threads = 1; }
+
+    board = new Board(size, k);
+    try {
+        table = resume ? new ValueTable(resume, true) : new ValueTable(*board);
+        if (!table->Matches(*board)) { throw "The table is for another board"; }
+        solved = new Solved(*board);
+    }
+    catch (const char *) {
+        delete table;
+        delete board;
+        throw;
+    }
+
+    TakeSample();
+}
+
+Learner::~Learner()
+{
+    delete[] sample;
+    delete solved;
+    delete table;
+    delete board;
+}
+
+void Learner::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s learn [options]\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --episodes N         games to play (1000000)\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --alpha A            learning rate (0.25)\n"
+            "  --epsilon E          share of random moves (0.1)\n"
+            "  --report MS          progress interval (1000)\n"
+            "  --out FILE           value table to write (ttt.values)\n"
+            "  --resume FILE        continue from a saved table\n", name);
+}
+
+int Learner::Run()
+{
+    pthread_t *tid = new pthread_t[threads];
+    int started = 0;
+    uint64_t start = Stats::Now(), last = start;
+    long long last_done = 0;
+
+    for (; started < threads; started++) {
+        if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+    }
+    if (started == 0) { Worker(this); }
+
+    /* Progress while the workers play */
+    while (__atomic_load_n(&done, __ATOMIC_RELAXED) < episodes) {
+        usleep(10000);
+
+        uint64_t now = Stats::Now();
+        if (now - last < report_ms * 1000000ULL) { continue; }
+
+        long long count = __atomic_load_n(&done, __ATOMIC_RELAXED);
+        Report(count, (now - start) / 1e9, 
+               (count - last_done) / ((now - last) / 1e9));
+        last = now;
+        last_done = count;
+    }
+
+    for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+    delete[] tid;
+
+    double sec = (Stats::Now() - start) / 1e9;
+    Report(episodes, sec, episodes / sec);
+
+    if (!table->Save(out_path)) {
+        fprintf(stderr, "Can't write %s\n", out_path);
+        return 1;
+    }
+    printf("%llu episodes in total, %zu bytes written to %s\n",
+           (unsigned long long)table->GetEpisodes(), table->GetBytes(), 
+           out_path);
+
+    return 0;
+}
+
+void Learner::Report(long long count, double sec, double rate)
+{
+    printf("%lld episodes, %.1f s, %.0f episodes/s, optimal moves %.2f%%\n",
+           count, sec, rate, 100 * Optimal());
+    fflush(stdout);
+}
+
+void *Learner::Worker(void *arg)
+{
+    Learner *l = static_cast<Learner *>(arg);
+    uint32_t explore = static_cast<uint32_t>(l->epsilon * 1048576);
+    Board b(l->size, l->k);
+    Rng rng(__atomic_fetch_add(&l->seed, 1, __ATOMIC_RELAXED));
+
+    for (;;) {
+        long long first = __atomic_fetch_add(&l->next, chunk, __ATOMIC_RELAXED);
+        if (first >= l->episodes) { break; }
+
+        long long n = l->episodes - first < chunk ? l->episodes - first : chunk;
+        for (long long i = 0; i < n; i++) { l->Episode(b, rng, explore); }
+
+        l->table->AddEpisodes(n);
+        __atomic_fetch_add(&l->done, n, __ATOMIC_RELAXED);
+    }
+
+    return 0;
+}
+
+void Learner::Episode(Board &b, Rng &rng, uint32_t explore)
+{
+    int prev = -1;      /* Position after the last move of the opponent */
+
+    b.Clear();
+
+    for (;;) {
+        int value;
+        int cell = table->Greedy(b, &rng, value);
+
+        if (prev >= 0) { table->Update(prev, -value, alpha); }
+        if (rng.Below(1048576) < explore) { cell = b.RandomFree(rng); }
+
+        b.Make(cell);
+        if (b.IsWinAt(cell) || b.IsFull()) { break; }
+
+        prev = table->Canonical(b);
+    }
+}
+
+void Learner::TakeSample()
+{
+    uint32_t codes = solved->GetCodeCount();
+    uint32_t reachable = solved->GetReachable();
+    uint32_t stride = reachable / max_sample + 1;
+    uint32_t seen = 0;
+
+    sample = new uint16_t[reachable / stride + 1][2];
+
+    for (uint32_t code = 0; code < codes; code++) {
+        if (solved->GetValue(code) == Solved::unknown) { continue; }
+        if (seen++ % stride) { continue; }
+
+        uint16_t m[2] = { 0, 0 };
+        uint32_t c = code;
+        for (int cell = 0; c; cell++, c /= 3) {
+            if (c % 3) { m[c % 3 - 1] |= 1 << cell; }
+        }
+
+        sample[sample_count][0] = m[0];
+        sample[sample_count][1] = m[1];
+        sample_count++;
+    }
+}
+
+double Learner::Optimal()
+{
+    int good = 0;
+
+    for (int i = 0; i < sample_count; i++) {
+        uint16_t m0 = sample[i][0], m1 = sample[i][1];
+        uint32_t code = 0, pow3 = 1;
+        int value;
+
+        /* Marks alternate, side 0 has the extra one if counts differ */
+        board->Clear();
+        while (m0 | m1) {
+            uint16_t &m = board->GetTurn() ? m1 : m0;
+            board->Make(__builtin_ctz(m));
+            m &= m - 1;
+        }
+        for (int cell = 0; cell < board->GetCellCount(); cell++, pow3 *= 3) {
+            code += pow3 * ((sample[i][0] >> cell & 1) 
+                            + 2 * (sample[i][1] >> cell & 1));
+        }
+
+        int cell = table->Greedy(*board, 0, value);
+        good += solved->GetBest(code) >> cell & 1;
+    }
+
+    return sample_count ? static_cast<double>(good) / sample_count : 0;
+}
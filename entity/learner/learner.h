@@ -0,0 +1,108 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEARNER_H_SENTRY
+#define LEARNER_H_SENTRY
+
+#include <stdint.h>
+
+#include "../board/board.h"
+#include "../rng/rng.h"
+#include "../solved/solved.h"
+#include "../value_table/value_table.h"
+
+/**
+ * @class Learner
+ * @brief Trains a ValueTable by self-play on all cores ("ttt learn").
+ * 
+ * Every move of an episode is the greedy move of the table, or a random
+ * one with probability epsilon. The position after the previous move
+ * of the opponent is moved toward minus the best value available to
+ * the side to move (Q-learning over positions after a move), so the
+ * table converges to the perfect-play values whatever the exploration.
+ * 
+ * Threads share the table without locks. While training runs, the
+ * episode rate and the share of positions where the greedy move is
+ * optimal according to Solved are reported.
+ */
+class Learner {
+private:
+    enum { chunk = 1024, max_sample = 65536 };
+
+    int size, k;
+    long long episodes;         /**< To play in this run */
+    int threads;
+    double alpha, epsilon;
+    long report_ms;
+    const char *out_path;
+    uint64_t seed;
+
+    Board *board;
+    ValueTable *table;
+    Solved *solved;
+
+    /** Masks of sides 0 and 1 of the checked positions */
+    uint16_t (*sample)[2];
+    int sample_count;
+
+    long long next;             /**< First episode of the next chunk */
+    long long done;             /**< Finished episodes */
+
+public:
+    /**
+     * @param argc, argv Options after "learn", see Learner::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Learner(int argc, char **argv);
+    ~Learner();
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Learner(Learner &l);
+    void operator=(Learner &l);
+
+    static void *Worker(void *arg);
+
+    /**
+     * @brief Plays and learns one game.
+     */
+    void Episode(Board &b, Rng &rng, uint32_t explore);
+
+    /**
+     * @brief Picks the positions of the convergence check.
+     */
+    void TakeSample();
+
+    /**
+     * @return Share of sampled positions where the greedy move is optimal.
+     */
+    double Optimal();
+
+    void Report(long long count, double sec, double rate);
+};
+
+#endif /* LEARNER_H_SENTRY */
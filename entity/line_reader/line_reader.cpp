@@ -0,0 +1,162 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+
+#include "line_reader.h"
+
+LineReader::LineReader(int fd)
+    : fd(fd)
+    , begin(0)
+    , end(0)
+    , eof(false)
+    , skip_tail(false)
+    , timer_fd(-1)
+    , interrupted(false)
+{
+    memset(buff, 0, sizeof(buff));
+}
+
+const char *LineReader::ReadLine(size_t *len)
+{
+    size_t scan = begin;
+
+    interrupted = false;
+
+    for (;;) {
+        char *nl = static_cast<char *>(memchr(buff + scan, '\n', end - scan));
+
+        if (nl) {
+            char *line = buff + begin;
+            size_t line_len = nl - line;
+
+            begin = nl - buff + 1;
+            scan = begin;
+
+            /* The tail of an overlong line */
+            if (skip_tail) { 
+                skip_tail = false;
+                continue; 
+            }
+
+            if (line_len > 0 && line[line_len - 1] == '\r') { line_len--; }
+            line[line_len] = '\0';
+
+            if (len) { *len = line_len; }
+            return line;
+        }
+
+        if (skip_tail) { begin = end = 0; }
+        else if (begin > 0) {
+            /* Move the incomplete line to the start of the buffer */
+            memmove(buff, buff + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        scan = end;
+
+        if (end == buff_size - 1) {
+            /* Return the head of an overlong line */
+            buff[end] = '\0';
+            if (len) { *len = end; }
+            skip_tail = true;
+            begin = end = 0;
+            return buff;
+        }
+
+        if (Fill() == 0) {
+            /* The partial line waits for the next call */
+            if (interrupted) { return 0; }
+
+            if (end == begin || skip_tail) {
+                begin = end = 0;
+                return 0;
+            }
+
+            /* The last line has no "\n" */
+            buff[end] = '\0';
+            if (len) { *len = end - begin; }
+
+            char *line = buff + begin;
+            begin = end;
+            return line;
+        }
+    }
+}
+
+void LineReader::Discard()
+{
+    begin = end = 0;
+    skip_tail = false;
+}
+
+void LineReader::SetTimer(int fd)
+{
+    timer_fd = fd;
+}
+
+bool LineReader::IsInterrupted() const
+{
+    return interrupted;
+}
+
+int LineReader::GetFd() const
+{
+    return fd;
+}
+
+bool LineReader::IsEof() const
+{
+    return eof && begin == end;
+}
+
+size_t LineReader::Fill()
+{
+    if (eof) { return 0; }
+
+    for (;;) {
+        if (timer_fd != -1) {
+            pollfd fds[2] = { { fd, POLLIN, 0 }, { timer_fd, POLLIN, 0 } };
+
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) { continue; }
+            }
+            else if (!fds[0].revents && fds[1].revents) {
+                interrupted = true;
+                return 0;
+            }
+        }
+
+        ssize_t res = read(fd, buff + end, buff_size - 1 - end);
+
+        if (res > 0) {
+            end += res;
+            return res;
+        }
+
+        if (res < 0 && errno == EINTR) { continue; }
+
+        eof = true;
+        return 0;
+    }
+}
@@ -0,0 +1,100 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LINE_READER_H_SENTRY
+#define LINE_READER_H_SENTRY
+
+#include <stddef.h>
+
+/**
+ * @class LineReader
+ * @brief Splits the byte stream of a file descriptor into lines.
+ * 
+ * A single read() may deliver several lines at once (pipes, files)
+ * or only a part of a line (slow terminals). The reader keeps the
+ * remainder between calls, so each ReadLine returns exactly one line.
+ */
+class LineReader {
+private:
+    enum { buff_size = 4096 };
+
+    int fd;                 /**< Source of the input             */
+    char buff[buff_size];   /**< Bytes read but not yet returned */
+    size_t begin;           /**< Start of the unreturned data    */
+    size_t end;             /**< End of the unreturned data      */
+    bool eof;               /**< The source has no more data     */
+    bool skip_tail;         /**< Rest of an overlong line is left */
+    int timer_fd;           /**< Interrupts the wait, -1 if none  */
+    bool interrupted;       /**< The last ReadLine was woken up   */
+
+public:
+    /**
+     * @param fd Readable file descriptor. It is not closed by the reader.
+     */
+    LineReader(int fd);
+
+    /**
+     * @brief Returns the next line of input.
+     * 
+     * @param[out] len Length of the line (can be NULL).
+     * @return Null-terminated line without the trailing "\n" or "\r\n",
+     *         or NULL if the input is over.
+     * 
+     * @note NULL is also returned when the timer descriptor becomes
+     *       readable first, see LineReader::IsInterrupted.
+     * @note The pointer is valid until the next call to the reader.
+     * @note Lines longer than the internal buffer are truncated,
+     *       the rest of such a line is skipped.
+     */
+    const char *ReadLine(size_t *len = 0);
+
+    /**
+     * @brief Drops all buffered bytes that have not been returned yet.
+     */
+    void Discard();
+
+    /**
+     * @brief Makes the waits for input end when the descriptor is readable.
+     * 
+     * @param fd E.g. MoveClock::GetFd, -1 to wait for input only.
+     *           It is not read or closed by the reader.
+     */
+    void SetTimer(int fd);
+
+    /** @return true if the last ReadLine returned NULL because of the timer */
+    bool IsInterrupted() const;
+
+    int GetFd() const;
+    bool IsEof() const;
+
+private:
+    LineReader(LineReader &lr);
+    void operator=(LineReader &lr);
+
+    /**
+     * @brief Reads more bytes from the descriptor into the buffer.
+     * 
+     * @return Number of bytes added, 0 at the end of input or when the
+     *         timer wakes up first.
+     */
+    size_t Fill();
+};
+
+#endif /* LINE_READER_H_SENTRY */
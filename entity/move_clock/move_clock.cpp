@@ -0,0 +1,146 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+#include "move_clock.h"
+#include "../stats/stats.h"
+
+MoveClock::MoveClock(const char *spec)
+    : fd(-1)
+    , running(-1)
+    , started(0)
+{
+    char *end;
+    long base_s = strtol(spec, &end, 10);
+    long inc_s = 0;
+
+    if (end == spec || base_s <= 0) { throw "Clock is BASE[+INC] in seconds"; }
+    if (*end == '+') {
+        spec = end + 1;
+        inc_s = strtol(spec, &end, 10);
+        if (end == spec || inc_s < 0) { throw "Clock is BASE[+INC] in seconds"; }
+    }
+    if (*end != '\0') { throw "Clock is BASE[+INC] in seconds"; }
+
+    base = base_s * 1000000000LL;
+    increment = inc_s * 1000000000LL;
+
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd == -1) { throw "Can't create the clock timer"; }
+
+    Reset();
+}
+
+MoveClock::~MoveClock()
+{
+    if (fd != -1) { close(fd); }
+}
+
+void MoveClock::Reset()
+{
+    left[man] = left[bot] = base;
+    running = -1;
+    Arm();
+}
+
+void MoveClock::Start(player_i side)
+{
+    if (running != -1) { return; }
+
+    running = side;
+    started = Stats::Now();
+    Arm();
+}
+
+bool MoveClock::Stop()
+{
+    if (running == -1) { return true; }
+
+    int64_t rest = GetRunningLeft();
+    bool in_time = rest > 0;
+
+    left[running] = in_time ? rest + increment : 0;
+    running = -1;
+    Arm();
+
+    return in_time;
+}
+
+bool MoveClock::Wake()
+{
+    uint64_t expirations;
+
+    /* Nonblocking: a tick that was already handled leaves nothing */
+    ssize_t res = read(fd, &expirations, sizeof(expirations));
+    (void)res;
+
+    if (running == -1) { return true; }
+    if (GetRunningLeft() <= 0) { return false; }
+
+    Arm();
+    return true;
+}
+
+long MoveClock::GetLeft(player_i side) const
+{
+    int64_t rest = side == running ? GetRunningLeft() : left[side];
+
+    return rest > 0 ? rest / 1000000 : 0;
+}
+
+void MoveClock::Format(long ms, char *buff, size_t size)
+{
+    /* Rounded up: 0:00.0 is shown only when the flag falls */
+    long tenths = (ms + 99) / 100;
+
+    snprintf(buff, size, "%ld:%02ld.%ld", tenths / 600, tenths / 10 % 60, 
+             tenths % 10);
+}
+
+int64_t MoveClock::GetRunningLeft() const
+{
+    return left[running] - static_cast<int64_t>(Stats::Now() - started);
+}
+
+void MoveClock::Arm()
+{
+    itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+
+    if (running != -1) {
+        uint64_t now = Stats::Now();
+        int64_t rest = left[running] - static_cast<int64_t>(now - started);
+
+        /* The shown tenth changes when the rest crosses a multiple of it */
+        int64_t wait = rest % tick_ns;
+        if (wait <= 0) { wait = rest > 0 ? tick_ns : 1; }
+
+        uint64_t at = now + wait;
+        spec.it_value.tv_sec = at / 1000000000ULL;
+        spec.it_value.tv_nsec = at % 1000000000ULL;
+    }
+
+    timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, 0);
+}
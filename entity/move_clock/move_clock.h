@@ -0,0 +1,113 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOVE_CLOCK_H_SENTRY
+#define MOVE_CLOCK_H_SENTRY
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../player_i.h"
+
+/**
+ * @class MoveClock
+ * @brief Chess clock of the two players with a Fischer increment.
+ * 
+ * The running side's deadline is armed on a timerfd, so a wait on its
+ * descriptor (see LineReader::SetTimer) wakes up exactly when the flag
+ * falls. Between that the timer also fires every time the shown tenth
+ * of a second changes. Time is measured on the monotonic clock in
+ * nanoseconds and only rounded for display.
+ */
+class MoveClock {
+private:
+    enum { tick_ns = 100000000 };   /**< Resolution of the display */
+
+    int fd;                         /**< timerfd, CLOCK_MONOTONIC */
+    int64_t base;                   /**< Time of each side at the start */
+    int64_t increment;              /**< Added after each move in time */
+    int64_t left[player_count];     /**< Not counting the running move */
+    int running;                    /**< Side to move, -1 if stopped */
+    uint64_t started;               /**< Stats::Now of the running move */
+
+public:
+    /**
+     * @param spec "BASE" or "BASE+INC" in seconds, e.g. "180+2".
+     * 
+     * @throws const char * if the spec is wrong or there is no timerfd.
+     */
+    explicit MoveClock(const char *spec);
+    ~MoveClock();
+
+    /**
+     * @brief Stops the clock and gives both sides the base time.
+     */
+    void Reset();
+
+    /**
+     * @brief Starts the time of the side, no-op if it's running.
+     */
+    void Start(player_i side);
+
+    /**
+     * @brief Stops the running side and adds the increment.
+     * 
+     * @return false if its flag has fallen, no increment then.
+     */
+    bool Stop();
+
+    /**
+     * @brief Handles the readable timer descriptor and arms the next tick.
+     * 
+     * @return false if the flag of the running side has fallen.
+     */
+    bool Wake();
+
+    /**
+     * @return Milliseconds left to the side, 0 after the flag fall.
+     */
+    long GetLeft(player_i side) const;
+
+    /** @return Side to move, -1 if the clock is stopped */
+    int GetRunning() const { return running; }
+
+    /** @brief Descriptor that is readable on a tick or the flag fall */
+    int GetFd() const { return fd; }
+
+    /**
+     * @brief Writes the time as "M:SS.t", rounded up to the tenth.
+     */
+    static void Format(long ms, char *buff, size_t size);
+
+private:
+    MoveClock(MoveClock &c);
+    void operator=(MoveClock &c);
+
+    /** @return Nanoseconds left to the running side, can be negative */
+    int64_t GetRunningLeft() const;
+
+    /**
+     * @brief Arms the timer at the next change of the shown time or the
+     *        flag fall, whichever is first; disarms it if stopped.
+     */
+    void Arm();
+};
+
+#endif /* MOVE_CLOCK_H_SENTRY */
@@ -0,0 +1,131 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "npy.h"
+
+NpyWriter::NpyWriter(const char *path, const char *descr, 
+                     size_t item_bytes, int row_width)
+    : row_width(row_width)
+    , row_bytes(item_bytes * (row_width ? row_width : 1))
+    , rows(0)
+    , buff_used(0)
+    , failed(false)
+{
+    strncpy(this->descr, descr, sizeof(this->descr) - 1);
+    this->descr[sizeof(this->descr) - 1] = '\0';
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) { throw "Can't create an .npy file"; }
+
+    buff = new char[buff_size];
+    WriteHeader();
+}
+
+NpyWriter::~NpyWriter()
+{
+    if (fd != -1) { Close(); }
+    delete[] buff;
+}
+
+void NpyWriter::Append(const void *data, size_t count)
+{
+    const char *src = static_cast<const char *>(data);
+    size_t size = count * row_bytes;
+
+    rows += count;
+
+    if (buff_used + size > buff_size) { Flush(); }
+    if (size >= buff_size) {
+        WriteAll(src, size);
+        return;
+    }
+
+    memcpy(buff + buff_used, src, size);
+    buff_used += size;
+}
+
+bool NpyWriter::Close()
+{
+    if (fd == -1) { return !failed; }
+
+    Flush();
+
+    if (lseek(fd, 0, SEEK_SET) == -1) { failed = true; }
+    else { WriteHeader(); }
+
+    if (close(fd) == -1) { failed = true; }
+    fd = -1;
+
+    return !failed;
+}
+
+void NpyWriter::Flush()
+{
+    WriteAll(buff, buff_used);
+    buff_used = 0;
+}
+
+void NpyWriter::WriteHeader()
+{
+    char header[header_size];
+    char dict[header_size];
+    char shape[48];
+    int len;
+
+    if (row_width) { snprintf(shape, sizeof(shape), "(%llu, %d)", rows, row_width); }
+    else { snprintf(shape, sizeof(shape), "(%llu,)", rows); }
+
+    len = snprintf(dict, sizeof(dict), 
+                   "{'descr': '%s', 'fortran_order': False, 'shape': %s, }",
+                   descr, shape);
+
+    /* Magic, version 1.0, little-endian length of the padded dictionary */
+    memcpy(header, "\x93NUMPY\x01\x00", 8);
+    header[8] = (header_size - 10) & 0xff;
+    header[9] = (header_size - 10) >> 8;
+
+    memset(header + 10, ' ', header_size - 10);
+    memcpy(header + 10, dict, len);
+    header[header_size - 1] = '\n';
+
+    WriteAll(header, header_size);
+}
+
+void NpyWriter::WriteAll(const char *data, size_t size)
+{
+    while (size > 0 && !failed) {
+        ssize_t res = write(fd, data, size);
+
+        if (res < 0) {
+            if (errno == EINTR) { continue; }
+            failed = true;
+            break;
+        }
+
+        data += res;
+        size -= res;
+    }
+}
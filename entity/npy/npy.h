@@ -0,0 +1,86 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef NPY_H_SENTRY
+#define NPY_H_SENTRY
+
+#include <stddef.h>
+
+/**
+ * @class NpyWriter
+ * @brief Streaming writer of a NumPy .npy array (format version 1.0).
+ * 
+ * Rows are appended through a large buffer and written with write(2).
+ * The header reserves a fixed width for the number of rows and is
+ * rewritten with the final shape on NpyWriter::Close.
+ */
+class NpyWriter {
+private:
+    enum { 
+        header_size = 128,      /**< Multiple of 64, as NumPy aligns */
+        buff_size = 1 << 20 
+    };
+
+    int fd;
+    char descr[8];              /**< NumPy type string, e.g. "|u1" */
+    int row_width;              /**< Elements per row, 0 for 1-D */
+    size_t row_bytes;
+    unsigned long long rows;
+    char *buff;
+    size_t buff_used;
+    bool failed;                /**< A write has failed */
+
+public:
+    /**
+     * @param path Created or truncated file.
+     * @param descr NumPy type string: "|u1", "|i1", "<u4", ...
+     * @param item_bytes Size of an element.
+     * @param row_width Elements per row, 0 for a 1-D array.
+     * 
+     * @throws const char * if the file can't be created.
+     */
+    NpyWriter(const char *path, const char *descr, 
+              size_t item_bytes, int row_width);
+    ~NpyWriter();
+
+    /**
+     * @brief Appends rows of row_width elements (one element for 1-D).
+     */
+    void Append(const void *data, size_t count);
+
+    /**
+     * @brief Flushes the buffer and writes the final header.
+     * 
+     * @return false if any write has failed.
+     */
+    bool Close();
+
+    unsigned long long GetRows() const { return rows; }
+
+private:
+    NpyWriter(NpyWriter &w);
+    void operator=(NpyWriter &w);
+
+    void Flush();
+    void WriteHeader();
+    void WriteAll(const char *data, size_t size);
+};
+
+#endif /* NPY_H_SENTRY */
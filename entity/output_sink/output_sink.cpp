@@ -0,0 +1,146 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "output_sink.h"
+
+OutputSink::~OutputSink()
+{}
+
+bool OutputSink::GetWindow(int &rows, int &cols) const
+{
+    rows = cols = 0;
+    return false;
+}
+
+void OutputSink::Print(const char *fmt, ...)
+{
+    char line[256];
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+
+    if (len > 0) { 
+        Write(line, static_cast<size_t>(len) < sizeof(line) ? len 
+                                                            : sizeof(line) - 1); 
+    }
+}
+
+void OutputSink::Puts(const char *str)
+{
+    Write(str, strlen(str));
+}
+
+OutputSink &OutputSink::Stdout()
+{
+    static FdSink sink(STDOUT_FILENO);
+
+    return sink;
+}
+
+FdSink::FdSink(int fd)
+    : fd(fd)
+{}
+
+void FdSink::Write(const char *data, size_t len)
+{
+    while (len > 0) {
+        ssize_t res = write(fd, data, len);
+
+        if (res < 0) {
+            if (errno == EINTR) { continue; }
+            return;
+        }
+
+        data += res;
+        len -= res;
+    }
+}
+
+bool FdSink::GetWindow(int &rows, int &cols) const
+{
+    winsize ws;
+
+    rows = cols = 0;
+    if (!isatty(fd)) { return false; }
+
+    /* A terminal that doesn't tell its size is the classic one */
+    if (ioctl(fd, TIOCGWINSZ, &ws) == 0 && ws.ws_row && ws.ws_col) {
+        rows = ws.ws_row;
+        cols = ws.ws_col;
+    }
+    else {
+        rows = 24;
+        cols = 80;
+    }
+
+    return true;
+}
+
+MemorySink::MemorySink(int rows, int cols)
+    : data(0)
+    , len(0)
+    , cap(0)
+    , rows(rows)
+    , cols(cols)
+{}
+
+MemorySink::~MemorySink()
+{
+    free(data);
+}
+
+void MemorySink::Write(const char *str, size_t size)
+{
+    if (len + size + 1 > cap) {
+        size_t new_cap = cap ? cap : 4096;
+
+        while (new_cap < len + size + 1) { new_cap *= 2; }
+
+        /* Out of memory: the bytes are lost, the old ones stay */
+        char *grown = static_cast<char *>(realloc(data, new_cap));
+        if (!grown) { return; }
+
+        data = grown;
+        cap = new_cap;
+    }
+
+    memcpy(data + len, str, size);
+    len += size;
+    data[len] = '\0';
+}
+
+bool MemorySink::GetWindow(int &rows, int &cols) const
+{
+    rows = this->rows;
+    cols = this->cols;
+
+    return rows > 0 && cols > 0;
+}
@@ -0,0 +1,144 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTPUT_SINK_H_SENTRY
+#define OUTPUT_SINK_H_SENTRY
+
+#include <stddef.h>
+
+/**
+ * @class OutputSink
+ * @brief Destination of the rendered text: a descriptor, memory or none.
+ * 
+ * ConsoleUI and Game write every byte they render through a sink, so
+ * the same renderer can draw on the terminal, fill a buffer for a
+ * benchmark or a recording, or feed a socket.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink();
+
+    /**
+     * @brief Takes the bytes, they may be kept until OutputSink::Flush.
+     */
+    virtual void Write(const char *data, size_t len) = 0;
+
+    /**
+     * @brief Passes on what Write has kept, before a wait for input.
+     */
+    virtual void Flush() {}
+
+    /**
+     * @brief Size of the terminal behind the sink.
+     * 
+     * @return false if it isn't a terminal.
+     */
+    virtual bool GetWindow(int &rows, int &cols) const;
+
+    /** @brief Formats up to a line of text and writes it */
+    void Print(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    void Puts(const char *str);
+    void Putc(char c) { Write(&c, 1); }
+
+    /**
+     * @brief The sink of the standard output, an FdSink.
+     */
+    static OutputSink &Stdout();
+};
+
+/**
+ * @class FdSink
+ * @brief Writes to a file descriptor (terminal, pipe, socket).
+ * 
+ * Each Write is one write(2), short writes and EINTR are retried, so
+ * a frame passed at once reaches the descriptor in one call.
+ */
+class FdSink : public OutputSink {
+private:
+    int fd;                 /**< Not closed by the sink */
+
+public:
+    explicit FdSink(int fd);
+
+    void Write(const char *data, size_t len);
+
+    /** @return The window size of the descriptor if it's a terminal */
+    bool GetWindow(int &rows, int &cols) const;
+
+private:
+    FdSink(FdSink &s);
+    void operator=(FdSink &s);
+};
+
+/**
+ * @class MemorySink
+ * @brief Collects the bytes in a buffer that doubles when it's full.
+ */
+class MemorySink : public OutputSink {
+private:
+    char *data;
+    size_t len, cap;
+    int rows, cols;         /**< Window it pretends to be, 0 if none */
+
+public:
+    /**
+     * @param rows, cols Terminal size reported by GetWindow,
+     *                   0 to be no terminal.
+     */
+    explicit MemorySink(int rows = 0, int cols = 0);
+    ~MemorySink();
+
+    void Write(const char *data, size_t len);
+    bool GetWindow(int &rows, int &cols) const;
+
+    /** @return The bytes written since the last Clear, NUL-terminated */
+    const char *GetData() const { return data ? data : ""; }
+    size_t GetLength() const { return len; }
+
+    /** @brief Drops the bytes, the memory is kept for reuse */
+    void Clear() 
+    { 
+        len = 0; 
+        if (data) { data[0] = '\0'; }
+    }
+
+private:
+    MemorySink(MemorySink &s);
+    void operator=(MemorySink &s);
+};
+
+/**
+ * @class NullSink
+ * @brief Drops the bytes, only counts them.
+ */
+class NullSink : public OutputSink {
+private:
+    unsigned long long bytes;
+
+public:
+    NullSink() : bytes(0) {}
+
+    void Write(const char *, size_t len) { bytes += len; }
+
+    unsigned long long GetBytes() const { return bytes; }
+};
+
+#endif /* OUTPUT_SINK_H_SENTRY */
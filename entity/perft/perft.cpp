@@ -0,0 +1,195 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "perft.h"
+#include "../stats/stats.h"
+
+Perft::Perft(int argc, char **argv)
+    : size(3)
+    , k(0)
+    , depth(0)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , divide(false)
+    , verify(false)
+    , root_counts(0)
+    , next_root(0)
+    , mismatches(0)
+{
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--divide") == 0) { 
+            divide = true; 
+            continue;
+        }
+        if (strcmp(argv[i], "--verify") == 0) { 
+            verify = true; 
+            continue;
+        }
+
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--size") == 0) { size = atoi(val); }
+        else if (strcmp(argv[i - 1], "--k") == 0) { k = atoi(val); }
+        else if (strcmp(argv[i - 1], "--depth") == 0) { depth = atoi(val); }
+        else if (strcmp(argv[i - 1], "--threads") == 0) { threads = atoi(val); }
+        else { throw "Unknown option"; }
+    }
+
+    if (k == 0) { k = size; }
+    if (threads < 1) { threads = 1; }
+
+    /* Validates the size and k */
+    Board check(size, k);
+
+    if (depth == 0) { depth = size * size; }
+    if (depth < 1 || depth > size * size) { throw "Bad depth"; }
+
+    root_counts = new counts[Board::max_cells][Board::max_cells + 1];
+    memset(root_counts, 0, Board::max_cells * sizeof(*root_counts));
+}
+
+Perft::~Perft()
+{
+    delete[] root_counts;
+}
+
+void Perft::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s perft [options]\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --depth D            plies to walk (all cells)\n"
+            "  --divide             positions at depth D by root move\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --verify             check each win against a full scan\n", 
+            name);
+}
+
+int Perft::Run()
+{
+    int cells = size * size;
+    pthread_t *tid = new pthread_t[threads];
+    int started = 0;
+    uint64_t start = Stats::Now();
+    counts total[Board::max_cells + 1];
+    long long all = 0;
+
+    for (; started < threads && started < cells; started++) {
+        if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+    }
+    if (started == 0) { Worker(this); }
+
+    for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+    delete[] tid;
+
+    double sec = (Stats::Now() - start) / 1e9;
+
+    memset(total, 0, sizeof(total));
+    for (int cell = 0; cell < cells; cell++) {
+        for (int ply = 1; ply <= depth; ply++) {
+            total[ply].nodes += root_counts[cell][ply].nodes;
+            total[ply].wins += root_counts[cell][ply].wins;
+            total[ply].draws += root_counts[cell][ply].draws;
+        }
+    }
+
+    printf("perft %dx%d k=%d, depth %d, %d threads\n", 
+           size, size, k, depth, started ? started : 1);
+    printf("%4s %16s %14s %14s\n", "ply", "nodes", "wins", "draws");
+    for (int ply = 1; ply <= depth; ply++) {
+        printf("%4d %16lld %14lld %14lld\n", ply, total[ply].nodes, 
+               total[ply].wins, total[ply].draws);
+        all += total[ply].nodes;
+    }
+
+    if (divide) {
+        Board board(size, k);
+        char move[4];
+
+        printf("divide at ply %d:\n", depth);
+        for (int cell = 0; cell < cells; cell++) {
+            board.FormatMove(cell, move);
+            printf("%s %lld\n", move, root_counts[cell][depth].nodes);
+        }
+    }
+
+    printf("%lld nodes in %.3f s (%.0f nodes/s)\n", 
+           all, sec, all / (sec > 0 ? sec : 1));
+
+    if (mismatches) {
+        fprintf(stderr, "%lld win checks differ from the scan\n", mismatches);
+        return 1;
+    }
+
+    return 0;
+}
+
+void *Perft::Worker(void *arg)
+{
+    Perft *p = static_cast<Perft *>(arg);
+    Board b(p->size, p->k);
+
+    for (;;) {
+        int cell = __atomic_fetch_add(&p->next_root, 1, __ATOMIC_RELAXED);
+        if (cell >= p->size * p->size) { break; }
+
+        b.Make(cell);
+        p->Walk(b, cell, 1, p->root_counts[cell]);
+        b.Unmake();
+    }
+
+    return 0;
+}
+
+void Perft::Walk(Board &b, int cell, int ply, counts *c)
+{
+    bool win = b.IsWinAt(cell);
+
+    c[ply].nodes++;
+
+    if (verify && win != b.IsWin(!b.GetTurn())) {
+        __atomic_fetch_add(&mismatches, 1, __ATOMIC_RELAXED);
+    }
+
+    if (win) { 
+        c[ply].wins++;
+        return;
+    }
+    if (b.IsFull()) {
+        c[ply].draws++;
+        return;
+    }
+    if (ply == depth) { return; }
+
+    for (uint64_t free = b.GetFree(); free; free &= free - 1) {
+        int next = __builtin_ctzll(free);
+
+        b.Make(next);
+        Walk(b, next, ply + 1, c);
+        b.Unmake();
+    }
+}
@@ -0,0 +1,94 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERFT_H_SENTRY
+#define PERFT_H_SENTRY
+
+#include "../board/board.h"
+
+/**
+ * @class Perft
+ * @brief Counts of the game tree of the empty board ("ttt perft").
+ * 
+ * Every sequence of moves up to the given depth is made and taken back
+ * on a Board; a game stops at a win or a full field, as in
+ * Game::CheckGameOver. For each ply the positions, the wins and the
+ * draws are counted, which checks the move generation and the win
+ * detection against known numbers (255168 games of 3x3).
+ * 
+ * The root moves are split among the threads, each walks its own
+ * board. The counts are kept per root move, so the divide (the
+ * positions at the last ply under every root move) costs nothing.
+ */
+class Perft {
+private:
+    /**
+     * @struct counts
+     * @brief Positions reached at a ply and how many of them ended.
+     */
+    struct counts {
+        long long nodes;
+        long long wins;         /**< The move to the ply won */
+        long long draws;        /**< The move to the ply filled the field */
+    };
+
+    int size, k;
+    int depth;                  /**< Plies to walk */
+    int threads;
+    bool divide;                /**< Print the counts of each root move */
+    bool verify;                /**< Compare Board::IsWinAt with a scan */
+
+    /** By root move and ply, [Board::max_cells][Board::max_cells + 1] */
+    counts (*root_counts)[Board::max_cells + 1];
+    int next_root;              /**< Next root move to walk */
+    long long mismatches;       /**< Win checks that disagree */
+
+public:
+    /**
+     * @param argc, argv Options after "perft", see Perft::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Perft(int argc, char **argv);
+    ~Perft();
+
+    /**
+     * @return Exit status of the program, non-zero on mismatches.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Perft(Perft &p);
+    void operator=(Perft &p);
+
+    static void *Worker(void *arg);
+
+    /**
+     * @brief Counts the position after a move and walks below it.
+     * 
+     * @param ply Moves made on the board, the last one is cell.
+     * @param c Counts of the root move by ply.
+     */
+    void Walk(Board &b, int cell, int ply, counts *c);
+};
+
+#endif /* PERFT_H_SENTRY */
@@ -26,7 +26,6 @@
  * @brief Indexes for the array of players.
  * 
  * @see Game::plr
- * @see Bot::move_stat
  */
 enum player_i { man = 0, bot = 1, player_count = 2 };
 
@@ -0,0 +1,174 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "qubic.h"
+#include "../rng/rng.h"
+
+uint64_t Qubic::lines[line_count];
+uint8_t Qubic::cell_lines[cell_count][cell_lines_max];
+uint8_t Qubic::cell_line_count[cell_count];
+uint64_t Qubic::zobrist[2][cell_count];
+pthread_once_t Qubic::tables_once = PTHREAD_ONCE_INIT;
+
+/** Score of an open line by the marks in it */
+static const int line_weight[Qubic::size + 1] = { 0, 1, 6, 40, 0 };
+
+Qubic::Qubic()
+{
+    pthread_once(&tables_once, BuildTables);
+
+    Clear();
+}
+
+void Qubic::BuildTables()
+{
+    int count = 0;
+
+    /* One of each pair of opposite directions: the first non-zero step is positive */
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int first = dz ? dz : dy ? dy : dx;
+
+                if (first <= 0) { continue; }
+
+                for (int z = 0; z < size; z++) {
+                    for (int y = 0; y < size; y++) {
+                        for (int x = 0; x < size; x++) {
+                            int ez = z + 3 * dz, ey = y + 3 * dy, ex = x + 3 * dx;
+                            uint64_t line = 0;
+
+                            if (ez < 0 || ez >= size || ey < 0 || ey >= size || 
+                                ex < 0 || ex >= size) { 
+                                continue; 
+                            }
+
+                            for (int i = 0; i < size; i++) {
+                                int cell = (z + i * dz) * 16 + (y + i * dy) * 4 
+                                           + x + i * dx;
+                                line |= 1ULL << cell;
+                            }
+                            lines[count++] = line;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (int cell = 0; cell < cell_count; cell++) {
+        cell_line_count[cell] = 0;
+        for (int l = 0; l < line_count; l++) {
+            if (lines[l] >> cell & 1) { 
+                cell_lines[cell][cell_line_count[cell]++] = l; 
+            }
+        }
+    }
+
+    /* Fixed keys: hashes are the same in every run */
+    Rng rng(0x5175626963ULL);
+    for (int side = 0; side < 2; side++) {
+        for (int cell = 0; cell < cell_count; cell++) { 
+            zobrist[side][cell] = rng.Next(); 
+        }
+    }
+}
+
+void Qubic::Clear()
+{
+    mask[0] = mask[1] = 0;
+    hash = 0;
+    won = false;
+    move_count = 0;
+}
+
+bool Qubic::IsLineAt(int side, int cell) const
+{
+    for (int i = 0; i < cell_line_count[cell]; i++) {
+        uint64_t line = lines[cell_lines[cell][i]];
+        if (__builtin_popcountll(mask[side] & line) == size) { return true; }
+    }
+
+    return false;
+}
+
+uint64_t Qubic::GetWinCells(int side) const
+{
+    uint64_t res = 0;
+
+    for (int l = 0; l < line_count; l++) {
+        if (!(mask[!side] & lines[l]) && 
+            __builtin_popcountll(mask[side] & lines[l]) == size - 1) {
+            res |= lines[l] & ~mask[side];
+        }
+    }
+
+    return res;
+}
+
+uint64_t Qubic::GetThreatCells(int side) const
+{
+    uint64_t res = 0;
+
+    for (int l = 0; l < line_count; l++) {
+        if (!(mask[!side] & lines[l]) && 
+            __builtin_popcountll(mask[side] & lines[l]) == size - 2) {
+            res |= lines[l] & ~mask[side];
+        }
+    }
+
+    return res;
+}
+
+int Qubic::Evaluate(int side) const
+{
+    int score = 0;
+
+    for (int l = 0; l < line_count; l++) {
+        int own = __builtin_popcountll(mask[side] & lines[l]);
+        int opp = __builtin_popcountll(mask[!side] & lines[l]);
+
+        if (!opp) { score += line_weight[own]; }
+        if (!own) { score -= line_weight[opp]; }
+    }
+
+    return score;
+}
+
+void Qubic::Make(int cell)
+{
+    int side = GetTurn();
+
+    mask[side] |= 1ULL << cell;
+    hash ^= zobrist[side][cell];
+    history[move_count++] = cell;
+    won = IsLineAt(side, cell);
+}
+
+void Qubic::Unmake()
+{
+    int cell = history[--move_count];
+
+    mask[GetTurn()] &= ~(1ULL << cell);
+    hash ^= zobrist[GetTurn()][cell];
+
+    /* Play stops at a win, so no earlier move made a line */
+    won = false;
+}
@@ -0,0 +1,126 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUBIC_H_SENTRY
+#define QUBIC_H_SENTRY
+
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @class Qubic
+ * @brief 4x4x4 tic-tac-toe position, one 64-bit mask per side.
+ * 
+ * Cell numbers are layer * 16 + row * 4 + col. All 76 winning lines
+ * (rows, columns and pillars, the diagonals of the 18 planes and the 4
+ * space diagonals) are precomputed as masks together with the lines
+ * through every cell, so the win check after a move is a popcount of
+ * at most 7 masks, and the cells that win at once are found from the
+ * lines with three own marks and no others.
+ */
+class Qubic {
+public:
+    enum { 
+        size = 4, 
+        cell_count = 64, 
+        line_count = 76,
+        cell_lines_max = 7          /**< Corners and the inner 8 cells */
+    };
+
+private:
+    static uint64_t lines[line_count];
+    static uint8_t cell_lines[cell_count][cell_lines_max];
+    static uint8_t cell_line_count[cell_count];
+    static uint64_t zobrist[2][cell_count];
+    static pthread_once_t tables_once;
+
+    uint64_t mask[2];
+    uint64_t hash;                  /**< Zobrist hash of the marks */
+    int history[cell_count];
+    bool won;                       /**< The last move made a line */
+    int move_count;
+
+public:
+    Qubic();
+
+    void Clear();
+
+    int GetTurn() const { return move_count & 1; }
+    int GetMoveCount() const { return move_count; }
+    int GetLastMove() const 
+        { return move_count ? history[move_count - 1] : -1; }
+    int GetMove(int i) const { return history[i]; }
+
+    uint64_t GetMask(int side) const { return mask[side]; }
+    uint64_t GetHash() const { return hash; }
+    uint64_t GetFree() const { return ~(mask[0] | mask[1]); }
+    bool IsFree(int cell) const { return GetFree() >> cell & 1; }
+
+    /** @return 0 if free, 1 or 2 for a mark of side 0 or 1 */
+    int GetMark(int cell) const 
+        { return (mask[0] >> cell & 1) ? 1 : (mask[1] >> cell & 1) ? 2 : 0; }
+
+    bool IsWon() const { return won; }
+    bool IsFull() const { return move_count == cell_count; }
+
+    static uint64_t GetLine(int index) { return lines[index]; }
+    static int GetCellLineCount(int cell) { return cell_line_count[cell]; }
+    static int GetCellLine(int cell, int i) { return cell_lines[cell][i]; }
+
+    /**
+     * @brief Free cells that complete a line of the side.
+     */
+    uint64_t GetWinCells(int side) const;
+
+    /**
+     * @brief Free cells where a mark of the side makes a winning cell:
+     *        the free cells of lines with two own marks and no others.
+     */
+    uint64_t GetThreatCells(int side) const;
+
+    /**
+     * @brief Static score for the side: open lines weighted by the
+     *        number of own marks, minus the same for the opponent.
+     */
+    int Evaluate(int side) const;
+
+    /**
+     * @brief Places a mark of the side to move into a free cell.
+     */
+    void Make(int cell);
+
+    /**
+     * @brief Takes back the last move.
+     */
+    void Unmake();
+
+private:
+    Qubic(Qubic &q);
+    void operator=(Qubic &q);
+
+    static void BuildTables();
+
+    /**
+     * @return The cell completes a line of the side.
+     */
+    bool IsLineAt(int side, int cell) const;
+};
+
+#endif /* QUBIC_H_SENTRY */
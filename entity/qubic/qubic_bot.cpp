@@ -0,0 +1,251 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "qubic_bot.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
+
+QubicBot::QubicBot()
+    : table(new entry[table_size])
+    , nodes(0)
+    , depth(0)
+    , deadline(0)
+    , aborted(false)
+{
+    memset(table, 0, table_size * sizeof(entry));
+}
+
+QubicBot::~QubicBot()
+{
+    delete[] table;
+}
+
+int QubicBot::Choose(Qubic &game, long movetime)
+{
+    TraceSpan span("QubicBot::Choose");
+    int moves[Qubic::cell_count];
+    int count, best;
+
+    nodes = 0;
+    depth = 0;
+
+    count = OrderMoves(game, game.GetFree(), -1, moves);
+    if (count == 0) { return -1; }
+    best = moves[0];
+
+    deadline = Stats::Now() + movetime * 1000000ULL;
+    aborted = false;
+
+    for (int d = 1; d <= Qubic::cell_count - game.GetMoveCount(); d++) {
+        int alpha = -win_score - 1, iter_best = best;
+
+        /* The best move of the last iteration goes first */
+        for (int i = 0; i < count; i++) {
+            if (moves[i] == best) {
+                moves[i] = moves[0];
+                moves[0] = best;
+                break;
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            int score;
+
+            game.Make(moves[i]);
+            score = game.IsWon() ? win_score 
+                                 : -Search(game, d - 1, -win_score - 1, -alpha, 1);
+            game.Unmake();
+
+            if (aborted) { break; }
+            if (score > alpha) {
+                alpha = score;
+                iter_best = moves[i];
+            }
+        }
+
+        if (aborted) { break; }
+
+        best = iter_best;
+        depth = d;
+
+        /* Decided: a forced win, or every move loses anyway */
+        if (alpha >= win_bound || alpha <= -win_bound) { break; }
+    }
+
+    return best;
+}
+
+int QubicBot::Analyze(Qubic &game, long movetime, int *scores)
+{
+    TraceSpan span("QubicBot::Analyze");
+    int moves[Qubic::cell_count];
+    int iter[Qubic::cell_count];
+    int count;
+
+    nodes = 0;
+    depth = 0;
+
+    count = OrderMoves(game, game.GetFree(), -1, moves);
+    deadline = Stats::Now() + movetime * 1000000ULL;
+    aborted = false;
+
+    for (int d = 1; d <= count; d++) {
+        bool decided = true;
+
+        for (int i = 0; i < count && !aborted; i++) {
+            int score;
+
+            game.Make(moves[i]);
+            score = game.IsWon() ? win_score 
+                                 : -Search(game, d - 1, -win_score - 1, 
+                                           win_score + 1, 1);
+            game.Unmake();
+
+            iter[moves[i]] = score;
+            if (score < win_bound && score > -win_bound) { decided = false; }
+        }
+
+        if (aborted) { break; }
+
+        for (int i = 0; i < count; i++) { scores[moves[i]] = iter[moves[i]]; }
+        depth = d;
+
+        if (decided) { break; }
+    }
+
+    return depth;
+}
+
+int QubicBot::Search(Qubic &game, int depth, int alpha, int beta, int ply)
+{
+    int me = game.GetTurn();
+    int moves[Qubic::cell_count];
+    uint64_t forced, cells;
+    entry &e = table[game.GetHash() & (table_size - 1)];
+    int count, best, best_move = -1, alpha0 = alpha;
+    bool quiet;
+
+    if ((++nodes & 1023) == 0 && Stats::Now() > deadline) { aborted = true; }
+    if (aborted) { return 0; }
+
+    if (game.GetWinCells(me)) { return win_score - ply; }
+
+    if (e.key == game.GetHash()) {
+        int score = e.score;
+
+        if (score >= win_bound) { score -= ply; }
+        if (score <= -win_bound) { score += ply; }
+
+        if (e.depth >= depth) {
+            if (e.flag == exact) { return score; }
+            if (e.flag == lower && score >= beta) { return score; }
+            if (e.flag == upper && score <= alpha) { return score; }
+        }
+        best_move = e.move;
+    }
+
+    forced = game.GetWinCells(!me);
+    quiet = !forced && depth <= 0;
+
+    if (forced) {
+        if (forced & (forced - 1)) { return -(win_score - ply - 1); }
+        cells = forced;
+        best = -win_score - 1;
+    }
+    else if (quiet) {
+        /* Threats only, the side may also stop here */
+        best = game.Evaluate(me);
+        if (best >= beta || depth <= -threat_plies) { return best; }
+        if (best > alpha) { alpha = best; }
+        cells = game.GetThreatCells(me) & game.GetFree();
+    }
+    else {
+        best = -win_score - 1;
+        cells = game.GetFree();
+    }
+
+    if (!cells) { return quiet ? best : 0; }
+
+    count = OrderMoves(game, cells, best_move, moves);
+    for (int i = 0; i < count; i++) {
+        int score;
+
+        game.Make(moves[i]);
+        score = -Search(game, forced ? depth : depth - 1, -beta, -alpha, ply + 1);
+        game.Unmake();
+
+        if (aborted) { return 0; }
+        if (score > best) { 
+            best = score; 
+            best_move = moves[i];
+        }
+        if (score > alpha) { alpha = score; }
+        if (alpha >= beta) { break; }
+    }
+
+    /* Deeper results replace shallower ones */
+    if (e.key != game.GetHash() || e.depth <= depth) {
+        e.key = game.GetHash();
+        e.score = best >= win_bound ? best + ply : 
+                  best <= -win_bound ? best - ply : best;
+        e.depth = depth < -threat_plies ? -threat_plies : depth;
+        e.flag = best <= alpha0 ? upper : best >= beta ? lower : exact;
+        e.move = best_move;
+    }
+
+    return best;
+}
+
+int QubicBot::OrderMoves(const Qubic &game, uint64_t cells, int first, 
+                         int *moves)
+{
+    static const int weight[Qubic::size] = { 1, 3, 12, 100 };
+    int score[Qubic::cell_count];
+    int me = game.GetTurn();
+    int count = 0;
+
+    for (; cells; cells &= cells - 1) {
+        int cell = __builtin_ctzll(cells), s = 0, i;
+
+        for (int l = 0; l < Qubic::GetCellLineCount(cell); l++) {
+            uint64_t line = Qubic::GetLine(Qubic::GetCellLine(cell, l));
+            int own = __builtin_popcountll(game.GetMask(me) & line);
+            int opp = __builtin_popcountll(game.GetMask(!me) & line);
+
+            /* Lines it extends, and lines of the opponent it blocks */
+            if (!opp) { s += weight[own]; }
+            if (!own) { s += weight[opp]; }
+        }
+        if (cell == first) { s = 1 << 30; }
+
+        /* Insertion by score, the best first */
+        for (i = count; i > 0 && score[i - 1] < s; i--) {
+            moves[i] = moves[i - 1];
+            score[i] = score[i - 1];
+        }
+        moves[i] = cell;
+        score[i] = s;
+        count++;
+    }
+
+    return count;
+}
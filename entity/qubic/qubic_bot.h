@@ -0,0 +1,130 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUBIC_BOT_H_SENTRY
+#define QUBIC_BOT_H_SENTRY
+
+#include <stdint.h>
+
+#include "qubic.h"
+
+/**
+ * @class QubicBot
+ * @brief Iterative deepening alpha-beta search for Qubic.
+ * 
+ * A reply to a single threat (three in an open line) doesn't count as
+ * a ply, and two threats at once are a loss without search. Below the
+ * nominal depth only moves that make a threat are searched (up to
+ * QubicBot::threat_plies of them), so the forcing sequences that
+ * decide Qubic are read much deeper than the rest. Positions are kept
+ * in a transposition table by Qubic::GetHash.
+ */
+class QubicBot {
+public:
+    enum { 
+        win_score = 100000, 
+        win_bound = win_score - Qubic::cell_count   /**< Scores of wins */
+    };
+
+private:
+    enum { threat_plies = 8, table_size = 1 << 20 };
+
+    /**
+     * @enum bound
+     * @brief What a stored score says about the exact one.
+     */
+    enum bound { exact, lower, upper };
+
+    /**
+     * @struct entry
+     * @brief Result of a search of a position.
+     * 
+     * Wins and losses are stored as distances from the position.
+     */
+    struct entry {
+        uint64_t key;               /**< Qubic::GetHash, 0 is a free slot */
+        int32_t score;
+        int8_t depth;
+        uint8_t flag;               /**< QubicBot::bound */
+        int8_t move;                /**< Best move, -1 if none */
+    };
+
+    entry *table;
+
+    long long nodes;            /**< Of the last QubicBot::Choose */
+    int depth;                  /**< Deepest completed iteration */
+    uint64_t deadline;          /**< Stats::Now time */
+    bool aborted;
+
+public:
+    QubicBot();
+    ~QubicBot();
+
+    /**
+     * @brief Chooses a move for the side to move.
+     * 
+     * @param game Position, restored before return.
+     * @param movetime Milliseconds of the search.
+     * 
+     * @return Selected cell, -1 if the field is full.
+     */
+    int Choose(Qubic &game, long movetime);
+
+    /**
+     * @brief Scores every free cell for the side to move in one search.
+     * 
+     * Iterative deepening where each root move gets the full window;
+     * the scores of the last completed iteration are kept.
+     * 
+     * @param game Position, restored before return.
+     * @param movetime Milliseconds at most.
+     * @param[out] scores By cell, filled for the free cells only.
+     * 
+     * @return Depth of the scores, 0 if there was no time for one
+     *         iteration or the field is full.
+     */
+    int Analyze(Qubic &game, long movetime, int *scores);
+
+    long long GetNodes() const { return nodes; }
+    int GetDepth() const { return depth; }
+
+private:
+    QubicBot(QubicBot &b);
+    void operator=(QubicBot &b);
+
+    /**
+     * @brief Negamax score of the side to move.
+     * 
+     * @param depth Plies left, at 0 and below only threats are tried.
+     */
+    int Search(Qubic &game, int depth, int alpha, int beta, int ply);
+
+    /**
+     * @brief Lists the cells, the most promising first.
+     * 
+     * @param first Cell put before the others if it's listed, -1 if none.
+     * 
+     * @return Number of moves.
+     */
+    static int OrderMoves(const Qubic &game, uint64_t cells, int first, 
+                          int *moves);
+};
+
+#endif /* QUBIC_BOT_H_SENTRY */
@@ -0,0 +1,82 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+#include "rng.h"
+
+uint64_t Rng::default_seed = 0;
+pthread_once_t Rng::default_once = PTHREAD_ONCE_INIT;
+uint64_t Rng::streams = 0;
+
+/**
+ * @brief Next value of the splitmix64 sequence.
+ */
+static uint64_t SplitMix(uint64_t &x)
+{
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+Rng::Rng()
+{
+    uint64_t stream = __atomic_fetch_add(&streams, 1, __ATOMIC_RELAXED);
+    uint64_t x = GetDefaultSeed() ^ stream * 0xd1342543de82ef95ULL;
+
+    Seed(SplitMix(x));
+}
+
+Rng::Rng(uint64_t seed)
+{
+    Seed(seed);
+}
+
+void Rng::Seed(uint64_t seed)
+{
+    for (int i = 0; i < 4; i++) { s[i] = SplitMix(seed); }
+}
+
+void Rng::SetDefaultSeed(uint64_t seed)
+{
+    /* The clock can't replace the seed later */
+    pthread_once(&default_once, ClockSeed);
+    default_seed = seed;
+}
+
+uint64_t Rng::GetDefaultSeed()
+{
+    pthread_once(&default_once, ClockSeed);
+
+    return default_seed;
+}
+
+void Rng::ClockSeed()
+{
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    default_seed = ts.tv_sec * 1000000000ULL + ts.tv_nsec 
+                 + (static_cast<uint64_t>(getpid()) << 32);
+}
@@ -0,0 +1,109 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RNG_H_SENTRY
+#define RNG_H_SENTRY
+
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @class Rng
+ * @brief Per-instance xoshiro256** pseudo-random generator.
+ * 
+ * Generators created without a seed take the default seed (see
+ * Rng::SetDefaultSeed) combined with their creation number, so a run
+ * with the same default seed creates the same sequences in the same
+ * objects.
+ */
+class Rng {
+private:
+    uint64_t s[4];
+
+    static uint64_t default_seed;
+    static pthread_once_t default_once;
+    static uint64_t streams;    /**< Generators created without a seed */
+
+public:
+    /**
+     * @brief Seeds from the default seed and the creation number.
+     */
+    Rng();
+    explicit Rng(uint64_t seed);
+
+    /**
+     * @brief Restarts the sequence from the seed.
+     * 
+     * The seed is expanded by splitmix64, any value is fine.
+     */
+    void Seed(uint64_t seed);
+
+    uint64_t Next()
+    {
+        uint64_t res = Rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 45);
+
+        return res;
+    }
+
+    /**
+     * @brief Uniform number in [0; n) without modulo bias (Lemire).
+     * 
+     * @param n Upper bound, must be positive.
+     */
+    uint32_t Below(uint32_t n)
+    {
+        uint64_t m = (Next() >> 32) * n;
+
+        if (static_cast<uint32_t>(m) < n) {
+            uint32_t threshold = -n % n;
+            while (static_cast<uint32_t>(m) < threshold) {
+                m = (Next() >> 32) * n;
+            }
+        }
+
+        return m >> 32;
+    }
+
+    /**
+     * @brief Sets the seed of generators created without one.
+     * 
+     * Without a call, the seed is taken from the clock and the pid.
+     */
+    static void SetDefaultSeed(uint64_t seed);
+    static uint64_t GetDefaultSeed();
+
+private:
+    /**
+     * @brief Takes the default seed from the clock and the pid.
+     */
+    static void ClockSeed();
+
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif /* RNG_H_SENTRY */
@@ -0,0 +1,230 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "selfplay.h"
+#include "../trace/trace.h"
+
+SelfPlay::SelfPlay(const Board &board, int lanes, policy p, 
+                   const Solved *solved, uint64_t seed)
+    : board(board)
+    , solved(solved)
+    , batch(board)
+    , pol(p)
+    , rng(seed)
+    , lanes(lanes)
+    , full((1 << board.GetCellCount()) - 1)
+    , sink(0)
+    , hist(0)
+    , rows(0)
+    , games(0)
+    , plies(0)
+    , draws(0)
+{
+    if (board.GetCellCount() > 16) { throw "Board is too large"; }
+    if (lanes < 1) { throw "Bad number of lanes"; }
+    if (p == perfect && !solved) { throw "Perfect policy needs a table"; }
+
+    for (int cell = 0; cell < board.GetCellCount(); cell++) {
+        delta[0][cell] = solved ? solved->Delta(cell, 0) : 0;
+        delta[1][cell] = solved ? solved->Delta(cell, 1) : 0;
+    }
+
+    for (int m = 0; m < 256; m++) {
+        int n = 0;
+        memset(select_bit[m], 0, sizeof(select_bit[m]));
+        for (int bit = 0; bit < 8; bit++) {
+            if (m >> bit & 1) { select_bit[m][n++] = bit; }
+        }
+        bit_count[m] = n;
+    }
+
+    own = new uint16_t[lanes];
+    opp = new uint16_t[lanes];
+    code = new uint32_t[lanes];
+    ply = new uint8_t[lanes];
+    win = new uint8_t[lanes];
+
+    memset(own, 0, lanes * sizeof(uint16_t));
+    memset(opp, 0, lanes * sizeof(uint16_t));
+    memset(code, 0, lanes * sizeof(uint32_t));
+    memset(ply, 0, lanes);
+
+    wins[0] = wins[1] = 0;
+}
+
+SelfPlay::~SelfPlay()
+{
+    delete[] rows;
+    delete[] hist;
+    delete[] win;
+    delete[] ply;
+    delete[] code;
+    delete[] opp;
+    delete[] own;
+}
+
+void SelfPlay::SetSink(Dataset *d)
+{
+    int cells = board.GetCellCount();
+
+    if (!hist) {
+        hist = new Dataset::row[cells * lanes];
+        rows = new Dataset::row[cells * lanes];
+    }
+    sink = d;
+
+    /* Lanes restart so every exported game is complete */
+    memset(own, 0, lanes * sizeof(uint16_t));
+    memset(opp, 0, lanes * sizeof(uint16_t));
+    memset(code, 0, lanes * sizeof(uint32_t));
+    memset(ply, 0, lanes);
+}
+
+bool SelfPlay::ParsePolicy(const char *name, policy &p)
+{
+    if (strcmp(name, "perfect") == 0) { p = perfect; }
+    else if (strcmp(name, "rules") == 0) { p = rules; }
+    else if (strcmp(name, "random") == 0) { p = random; }
+    else { return false; }
+
+    return true;
+}
+
+void SelfPlay::Step()
+{
+    TraceSpan span("SelfPlay::Step");
+    int cells = board.GetCellCount();
+    long long lane_wins[2] = { 0, 0 };
+    long long lane_draws = 0, lane_games = 0;
+    int row_count = 0;
+
+    switch (pol) {
+        case perfect: Moves<perfect>(); break;
+        case rules: Moves<rules>(); break;
+        case random: Moves<random>(); break;
+    }
+
+    plies += lanes;
+
+    /* Game over checks of all lanes at once, the movers are in opp */
+    batch.Check(opp, lanes, win);
+
+    /* Results and refills */
+    for (int i = 0; i < lanes; i++) {
+        int w = win[i];
+        int over = w | (ply[i] == cells);
+        int side = (ply[i] - 1) & 1;
+        uint16_t keep = -static_cast<uint16_t>(!over);
+
+        lane_wins[side] += w;
+        lane_draws += over & !w;
+        lane_games += over;
+
+        if (sink && over) {
+            row_count += GameRows(i, w ? side : -1, rows + row_count);
+        }
+
+        own[i] &= keep;
+        opp[i] &= keep;
+        code[i] &= -static_cast<uint32_t>(!over);
+        ply[i] &= keep;
+    }
+
+    wins[0] += lane_wins[0];
+    wins[1] += lane_wins[1];
+    draws += lane_draws;
+    games += lane_games;
+
+    if (row_count) { sink->Add(rows, row_count); }
+}
+
+int SelfPlay::GameRows(int lane, int winner, Dataset::row *out) const
+{
+    int count = ply[lane];
+
+    for (int t = 0; t < count; t++) {
+        Dataset::row &r = out[t];
+
+        r = hist[t * lanes + lane];
+        r.outcome = winner < 0 ? 0 : (r.side == winner ? 1 : -1);
+    }
+
+    return count;
+}
+
+template <int P> void SelfPlay::Moves()
+{
+    const uint16_t *best = solved ? solved->GetBestTable() : 0;
+
+    for (int i = 0; i < lanes; i++) {
+        uint16_t o = own[i], p = opp[i];
+        uint16_t cand;
+
+        if (P == perfect) { cand = best[code[i]]; }
+        else if (P == rules) { cand = RuleMoves(o, p); }
+        else { cand = full & ~(o | p); }
+
+        int cell = RandomBit(cand);
+
+        if (sink) {
+            Dataset::row &r = hist[ply[i] * lanes + i];
+            r.own = o;
+            r.opp = p;
+            r.side = ply[i] & 1;
+            r.move = cell;
+        }
+
+        /* The opponent moves next */
+        code[i] += delta[ply[i] & 1][cell];
+        own[i] = p;
+        opp[i] = o | (1 << cell);
+        ply[i]++;
+    }
+}
+
+uint16_t SelfPlay::RuleMoves(uint16_t own, uint16_t opp) const
+{
+    uint16_t free = full & ~(own | opp);
+    uint16_t win_cells = 0, block_cells = 0;
+
+    /* 
+     * A line is one move from complete if the cells it lacks 
+     * are a single free cell
+     */
+    for (int l = 0; l < board.GetLineCount(); l++) {
+        uint16_t line = board.GetLine(l);
+        uint16_t own_lack = line & ~own;
+        uint16_t opp_lack = line & ~opp;
+
+        win_cells |= own_lack & free 
+                   & -static_cast<uint16_t>((own_lack & (own_lack - 1)) == 0);
+        block_cells |= opp_lack & free
+                     & -static_cast<uint16_t>((opp_lack & (opp_lack - 1)) == 0);
+    }
+
+    /* The first non-empty of win, block and free */
+    uint16_t has_win = -static_cast<uint16_t>(win_cells != 0);
+    uint16_t has_block = -static_cast<uint16_t>(block_cells != 0);
+
+    return win_cells | (block_cells & ~has_win) 
+         | (free & ~has_win & ~has_block);
+}
@@ -0,0 +1,172 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SELFPLAY_H_SENTRY
+#define SELFPLAY_H_SENTRY
+
+#include <stdint.h>
+
+#include "../board/board.h"
+#include "../rng/rng.h"
+#include "../solved/solved.h"
+#include "../win_batch/win_batch.h"
+#include "../dataset/dataset.h"
+
+/**
+ * @class SelfPlay
+ * @brief Lockstep simulation of many bot-vs-bot games.
+ * 
+ * Game states live in struct-of-arrays buffers, one element per lane.
+ * SelfPlay::Step advances every lane by one ply: the policy picks
+ * a move from masks without data-dependent branches, WinBatch checks
+ * all movers at once, and finished lanes are refilled with a new game
+ * in place.
+ * 
+ * @note Boards of up to 16 cells.
+ */
+class SelfPlay {
+public:
+    /**
+     * @enum policy
+     * @brief Move choice of both sides.
+     * 
+     * @var perfect Random optimal move from the Solved table.
+     * @var rules   Win, block, otherwise random (heuristic line counts).
+     * @var random  Any free cell.
+     */
+    enum policy { perfect, rules, random };
+
+private:
+    const Board &board;         /**< Rules */
+    const Solved *solved;       /**< Required by the perfect policy */
+    WinBatch batch;
+    policy pol;
+    Rng rng;
+
+    int lanes;
+    uint16_t full;              /**< Mask of all cells */
+
+    /** Solved code change by side and cell */
+    uint32_t delta[2][Solved::max_cells];
+
+    /** Position of the n-th set bit in a byte, by byte and n */
+    uint8_t select_bit[256][8];
+
+    /** Set bits in a byte (no popcnt instruction is assumed) */
+    uint8_t bit_count[256];
+
+    /* Lane buffers */
+    uint16_t *own;              /**< Marks of the side to move */
+    uint16_t *opp;              /**< Marks of the side that just moved */
+    uint32_t *code;             /**< Solved code of the position */
+    uint8_t *ply;               /**< Moves made */
+    uint8_t *win;               /**< WinBatch result */
+
+    /* Export */
+    Dataset *sink;              /**< Receives finished games, can be NULL */
+    Dataset::row *hist;         /**< Positions by ply and lane */
+    Dataset::row *rows;         /**< Rows of the games finished in a step */
+
+    /* Totals */
+    long long games;
+    long long plies;
+    long long wins[2];          /**< By side that won */
+    long long draws;
+
+public:
+    /**
+     * @param board Rules of the games, must outlive the object.
+     * @param lanes Number of simultaneous games.
+     * @param p Policy of both sides.
+     * @param solved Table for the perfect policy (can be NULL otherwise).
+     * @param seed Seed of the random choices.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    SelfPlay(const Board &board, int lanes, policy p, 
+             const Solved *solved, uint64_t seed);
+    ~SelfPlay();
+
+    /**
+     * @brief Advances every game by one ply.
+     */
+    void Step();
+
+    /**
+     * @brief Sends every position of the finished games to the dataset.
+     * 
+     * @note Call before the first step, games in progress are skipped.
+     */
+    void SetSink(Dataset *d);
+
+    long long GetGames() const { return games; }
+    long long GetPlies() const { return plies; }
+    long long GetWins(int side) const { return wins[side]; }
+    long long GetDraws() const { return draws; }
+
+    /**
+     * @brief Parses a policy name: "perfect", "rules" or "random".
+     * 
+     * @return false if the name is unknown.
+     */
+    static bool ParsePolicy(const char *name, policy &p);
+
+private:
+    SelfPlay(SelfPlay &s);
+    void operator=(SelfPlay &s);
+
+    /**
+     * @brief Makes a move in every lane.
+     * 
+     * @tparam P SelfPlay::policy, so the loop has no policy branch.
+     */
+    template <int P> void Moves();
+
+    /**
+     * @brief Appends the positions of a finished game to the rows.
+     * 
+     * @return Number of rows added.
+     */
+    int GameRows(int lane, int winner, Dataset::row *out) const;
+
+    /**
+     * @brief Candidate moves of the rules policy.
+     */
+    uint16_t RuleMoves(uint16_t own, uint16_t opp) const;
+
+    /**
+     * @brief Random set bit of a non-empty mask, without branches.
+     * 
+     * @note The draw is a 32-bit fixed-point multiply, its bias
+     *       is below 2^-27 for 16 cells.
+     */
+    int RandomBit(uint16_t m)
+    {
+        uint8_t lo = m, hi = m >> 8;
+        uint32_t lo_count = bit_count[lo];
+        uint32_t n = ((rng.Next() >> 32) * (lo_count + bit_count[hi])) >> 32;
+        int lo_bit = select_bit[lo][n & 7];
+        int hi_bit = 8 + select_bit[hi][(n - lo_count) & 7];
+
+        return n < lo_count ? lo_bit : hi_bit;
+    }
+};
+
+#endif /* SELFPLAY_H_SENTRY */
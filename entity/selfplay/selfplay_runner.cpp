@@ -0,0 +1,167 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "selfplay_runner.h"
+#include "../stats/stats.h"
+
+SelfPlayRunner::SelfPlayRunner(int argc, char **argv)
+    : size(3)
+    , k(0)
+    , lanes(4096)
+    , games(1000000)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , pol(SelfPlay::perfect)
+    , seed(Rng::GetDefaultSeed())
+    , board(0)
+    , solved(0)
+    , dataset(0)
+    , total_games(0)
+    , total_plies(0)
+    , total_draws(0)
+{
+    const char *export_dir = 0;
+    long dedup_mb = 64;
+
+    for (int i = 0; i < argc; i++) {
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--size") == 0) { size = atoi(val); }
+        else if (strcmp(argv[i - 1], "--k") == 0) { k = atoi(val); }
+        else if (strcmp(argv[i - 1], "--lanes") == 0) { lanes = atoi(val); }
+        else if (strcmp(argv[i - 1], "--games") == 0) { games = atoll(val); }
+        else if (strcmp(argv[i - 1], "--threads") == 0) { threads = atoi(val); }
+        else if (strcmp(argv[i - 1], "--policy") == 0) {
+            if (!SelfPlay::ParsePolicy(val, pol)) { throw "Unknown policy"; }
+        }
+        else if (strcmp(argv[i - 1], "--export-npy") == 0) { export_dir = val; }
+        else if (strcmp(argv[i - 1], "--dedup-mb") == 0) { dedup_mb = atol(val); }
+        else { throw "Unknown option"; }
+    }
+
+    if (k == 0) { k = size; }
+    if (size * size > 16) { throw "Board is too large"; }
+    if (lanes < 1 || games < 1 || dedup_mb < 1) { throw "Bad option value"; }
+    if (threads < 1) { threads = 1; }
+
+    board = new Board(size, k);
+    if (pol == SelfPlay::perfect) { solved = new Solved(*board); }
+    if (export_dir) {
+        try {
+            dataset = new Dataset(export_dir, *board, dedup_mb << 20);
+        }
+        catch (const char *) {
+            delete solved;
+            delete board;
+            throw;
+        }
+    }
+
+    total_wins[0] = total_wins[1] = 0;
+    pthread_mutex_init(&lock, 0);
+}
+
+SelfPlayRunner::~SelfPlayRunner()
+{
+    pthread_mutex_destroy(&lock);
+    delete dataset;
+    delete solved;
+    delete board;
+}
+
+void SelfPlayRunner::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s selfplay [options]\n"
+            "  --policy NAME        perfect, rules or random (perfect)\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --games N            games to finish (1000000)\n"
+            "  --lanes N            simultaneous games per thread (4096)\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --export-npy DIR     write positions to DIR/*.npy\n"
+            "  --dedup-mb N         memory for duplicate detection (64)\n",
+            name);
+}
+
+int SelfPlayRunner::Run()
+{
+    pthread_t *tid = new pthread_t[threads];
+    int started = 0;
+    uint64_t start = Stats::Now();
+
+    for (; started < threads; started++) {
+        if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+    }
+    if (started == 0) { Worker(this); }
+
+    for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+    delete[] tid;
+
+    double sec = (Stats::Now() - start) / 1e9;
+
+    printf("%lld games: side 0 wins %lld, side 1 wins %lld, draws %lld\n"
+           "%lld plies in %.3f s (%.1f Mplies/s, %.1f Mgames/s)\n",
+           total_games, total_wins[0], total_wins[1], total_draws,
+           total_plies, sec, total_plies / sec / 1e6, 
+           total_games / sec / 1e6);
+
+    if (dataset) {
+        if (!dataset->Close()) {
+            fprintf(stderr, "Failed to write the dataset\n");
+            return 1;
+        }
+        printf("%llu positions exported, %llu duplicates skipped\n",
+               dataset->GetRows(), dataset->GetDuplicates());
+    }
+
+    return 0;
+}
+
+void *SelfPlayRunner::Worker(void *arg)
+{
+    SelfPlayRunner *r = static_cast<SelfPlayRunner *>(arg);
+
+    pthread_mutex_lock(&r->lock);
+    uint64_t seed = r->seed++;
+    pthread_mutex_unlock(&r->lock);
+
+    SelfPlay sp(*r->board, r->lanes, r->pol, r->solved, seed);
+    if (r->dataset) { sp.SetSink(r->dataset); }
+
+    /* Each thread finishes its share, lanes may overshoot a little */
+    long long share = (r->games + r->threads - 1) / r->threads;
+    while (sp.GetGames() < share) { sp.Step(); }
+
+    pthread_mutex_lock(&r->lock);
+    r->total_games += sp.GetGames();
+    r->total_plies += sp.GetPlies();
+    r->total_wins[0] += sp.GetWins(0);
+    r->total_wins[1] += sp.GetWins(1);
+    r->total_draws += sp.GetDraws();
+    pthread_mutex_unlock(&r->lock);
+
+    return 0;
+}
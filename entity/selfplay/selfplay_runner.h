@@ -0,0 +1,75 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SELFPLAY_RUNNER_H_SENTRY
+#define SELFPLAY_RUNNER_H_SENTRY
+
+#include <pthread.h>
+
+#include "selfplay.h"
+
+/**
+ * @class SelfPlayRunner
+ * @brief Headless self-play on all cores ("ttt selfplay").
+ * 
+ * Every thread owns a SelfPlay with its own lanes and seed, the
+ * Solved table is built once and shared read-only.
+ */
+class SelfPlayRunner {
+private:
+    int size, k;
+    int lanes;                  /**< Per thread */
+    long long games;            /**< Total games to finish */
+    int threads;
+    SelfPlay::policy pol;
+    uint64_t seed;
+
+    Board *board;
+    Solved *solved;             /**< NULL unless the policy is perfect */
+    Dataset *dataset;           /**< NULL unless --export-npy is given */
+
+    /* Totals of the finished threads */
+    pthread_mutex_t lock;
+    long long total_games, total_plies, total_wins[2], total_draws;
+
+public:
+    /**
+     * @param argc, argv Options after "selfplay", see SelfPlayRunner::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    SelfPlayRunner(int argc, char **argv);
+    ~SelfPlayRunner();
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    SelfPlayRunner(SelfPlayRunner &r);
+    void operator=(SelfPlayRunner &r);
+
+    static void *Worker(void *arg);
+};
+
+#endif /* SELFPLAY_RUNNER_H_SENTRY */
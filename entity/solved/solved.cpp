@@ -0,0 +1,94 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "solved.h"
+
+Solved::Solved(const Board &rules)
+    : cells(rules.GetCellCount())
+    , reachable(0)
+{
+    if (cells > max_cells) { throw "Board is too large to solve"; }
+
+    pow3[0] = 1;
+    for (int i = 1; i <= cells; i++) { pow3[i] = pow3[i - 1] * 3; }
+    code_count = pow3[cells];
+
+    values = new int8_t[code_count];
+    best = new uint16_t[code_count];
+    memset(values, unknown, code_count);
+    memset(best, 0, code_count * sizeof(best[0]));
+
+    Board board(rules.GetSize(), rules.GetK());
+    Solve(board, 0);
+}
+
+Solved::~Solved()
+{
+    delete[] best;
+    delete[] values;
+}
+
+uint32_t Solved::Encode(const Board &board) const
+{
+    uint32_t code = 0;
+
+    for (int side = 0; side < 2; side++) {
+        uint64_t m = board.GetMask(side);
+        for (; m; m &= m - 1) { code += Delta(__builtin_ctzll(m), side); }
+    }
+
+    return code;
+}
+
+int Solved::Solve(Board &board, uint32_t code)
+{
+    if (values[code] != unknown) { return values[code]; }
+
+    int side = board.GetTurn();
+    int best_value = loss - 1;
+    uint16_t moves = 0;
+
+    for (int i = 0; i < board.GetFreeCount(); i++) {
+        int cell = board.GetFreeCell(i);
+        int v;
+
+        board.Make(cell);
+
+        if (board.IsWinAt(cell)) { v = win; }
+        else if (board.IsFull()) { v = draw; }
+        else { v = -Solve(board, code + Delta(cell, side)); }
+
+        board.Unmake();
+
+        if (v > best_value) {
+            best_value = v;
+            moves = 0;
+        }
+        if (v == best_value) { moves |= 1 << cell; }
+    }
+
+    values[code] = best_value;
+    best[code] = moves;
+    reachable++;
+
+    return best_value;
+}
@@ -0,0 +1,101 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLVED_H_SENTRY
+#define SOLVED_H_SENTRY
+
+#include <stdint.h>
+
+#include "../board/board.h"
+
+/**
+ * @class Solved
+ * @brief Perfect-play table of every reachable position of a small board.
+ * 
+ * A position is encoded in base 3: digit of a cell is 0 if it's free,
+ * 1 for a mark of side 0 and 2 for side 1. For each reachable code the
+ * table keeps the value for the side to move and the mask of moves
+ * that keep this value.
+ * 
+ * @note Boards of up to 16 cells (3^16 codes, 129 MB for 4x4).
+ */
+class Solved {
+public:
+    enum { max_cells = 16 };
+
+    /**
+     * @enum value
+     * @brief Result under perfect play for the side to move.
+     */
+    enum value { loss = -1, draw = 0, win = 1, unknown = 2 };
+
+private:
+    int cells;
+    uint32_t code_count;                /**< 3^cells */
+    uint32_t pow3[max_cells + 1];
+    int8_t *values;                     /**< Solved::value by code */
+    uint16_t *best;                     /**< Optimal moves by code */
+    uint32_t reachable;                 /**< Solved positions */
+
+public:
+    /**
+     * @brief Solves all positions reachable from the empty board.
+     * 
+     * @throws const char * if the board is too large.
+     */
+    Solved(const Board &rules);
+    ~Solved();
+
+    uint32_t GetCodeCount() const { return code_count; }
+    uint32_t GetReachable() const { return reachable; }
+
+    /**
+     * @brief Code change when the side puts a mark into the cell.
+     */
+    uint32_t Delta(int cell, int side) const { return pow3[cell] * (side + 1); }
+
+    /**
+     * @brief Base 3 code of the position.
+     */
+    uint32_t Encode(const Board &board) const;
+
+    value GetValue(uint32_t code) const { return static_cast<value>(values[code]); }
+
+    /**
+     * @return Mask of optimal moves, 0 for terminal or unreachable codes.
+     */
+    uint16_t GetBest(uint32_t code) const { return best[code]; }
+
+    /**
+     * @brief Table of optimal move masks for the lockstep loops.
+     */
+    const uint16_t *GetBestTable() const { return best; }
+
+private:
+    Solved(Solved &s);
+    void operator=(Solved &s);
+
+    /**
+     * @brief Negamax over the game tree, memoized by code.
+     */
+    int Solve(Board &board, uint32_t code);
+};
+
+#endif /* SOLVED_H_SENTRY */
@@ -0,0 +1,173 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "stats.h"
+
+bool Stats::enabled = false;
+Stats::histogram Stats::hist[Stats::phase_count];
+
+void Stats::Record(phase p, uint64_t ns)
+{
+    histogram &h = hist[p];
+
+    __atomic_fetch_add(&h.bucket[BucketIndex(ns)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h.sum, ns, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&h.count, 1, __ATOMIC_RELAXED);
+
+    /* Both bounds only grow: the minimum is kept inverted */
+    AtomicMax(h.min_not, ~ns);
+    AtomicMax(h.max, ns);
+}
+
+void Stats::AtomicMax(uint64_t &value, uint64_t x)
+{
+    uint64_t cur = __atomic_load_n(&value, __ATOMIC_RELAXED);
+
+    while (x > cur && 
+           !__atomic_compare_exchange_n(&value, &cur, x, true, 
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void Stats::Print(FILE *f)
+{
+    fprintf(f, "%-10s %8s %10s %10s %10s %10s %10s %10s  (us)\n", "phase", 
+            "count", "mean", "min", "p50", "p90", "p99", "max");
+
+    for (int i = 0; i < phase_count; i++) {
+        const histogram &h = hist[i];
+
+        if (h.count == 0) { continue; }
+
+        fprintf(f, "%-10s %8llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                Name(static_cast<phase>(i)), 
+                static_cast<unsigned long long>(h.count), 
+                h.sum / 1e3 / h.count, Min(h) / 1e3,
+                Percentile(h, 0.5) / 1e3, Percentile(h, 0.9) / 1e3,
+                Percentile(h, 0.99) / 1e3, h.max / 1e3);
+    }
+
+    fflush(f);
+}
+
+bool Stats::WriteJson(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) { return false; }
+
+    fprintf(f, "{\"unit\":\"ns\",\"phases\":{");
+
+    for (int i = 0; i < phase_count; i++) {
+        const histogram &h = hist[i];
+        bool first = true;
+
+        fprintf(f, "%s\"%s\":{\"count\":%llu,\"sum\":%llu,\"min\":%llu,"
+                "\"max\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,"
+                "\"buckets\":[", i ? "," : "", Name(static_cast<phase>(i)),
+                static_cast<unsigned long long>(h.count),
+                static_cast<unsigned long long>(h.sum),
+                static_cast<unsigned long long>(Min(h)),
+                static_cast<unsigned long long>(h.max),
+                static_cast<unsigned long long>(Percentile(h, 0.5)),
+                static_cast<unsigned long long>(Percentile(h, 0.9)),
+                static_cast<unsigned long long>(Percentile(h, 0.99)));
+
+        /* Only non-empty buckets as [low, high, count] */
+        for (int b = 0; b < bucket_count; b++) {
+            if (!h.bucket[b]) { continue; }
+
+            fprintf(f, "%s[%llu,%llu,%llu]", first ? "" : ",",
+                    static_cast<unsigned long long>(BucketLow(b)),
+                    static_cast<unsigned long long>(BucketHigh(b)),
+                    static_cast<unsigned long long>(h.bucket[b]));
+            first = false;
+        }
+
+        fprintf(f, "]}");
+    }
+
+    fprintf(f, "}}\n");
+
+    return fclose(f) == 0;
+}
+
+int Stats::BucketIndex(uint64_t ns)
+{
+    if (ns < sub_count) { return ns; }
+
+    int exp = 63 - __builtin_clzll(ns);
+    int sub = (ns >> (exp - sub_bits)) & (sub_count - 1);
+
+    return (exp - sub_bits + 1) * sub_count + sub;
+}
+
+uint64_t Stats::BucketLow(int index)
+{
+    if (index < sub_count) { return index; }
+
+    int exp = index / sub_count + sub_bits - 1;
+    int sub = index % sub_count;
+
+    return static_cast<uint64_t>(sub_count + sub) << (exp - sub_bits);
+}
+
+uint64_t Stats::BucketHigh(int index)
+{
+    if (index < sub_count) { return index; }
+
+    int exp = index / sub_count + sub_bits - 1;
+
+    return BucketLow(index) + (uint64_t(1) << (exp - sub_bits)) - 1;
+}
+
+uint64_t Stats::Percentile(const histogram &h, double q)
+{
+    uint64_t rank = static_cast<uint64_t>(q * h.count + 0.5);
+    uint64_t seen = 0;
+
+    if (rank == 0) { rank = 1; }
+
+    for (int b = 0; b < bucket_count; b++) {
+        seen += h.bucket[b];
+        if (seen >= rank) { 
+            uint64_t high = BucketHigh(b);
+            return high < h.max ? high : h.max; 
+        }
+    }
+
+    return h.max;
+}
+
+const char *Stats::Name(phase p)
+{
+    switch (p) {
+        case input: return "input";
+        case bot_move: return "bot_move";
+        case render: return "render";
+        case clear: return "clear";
+        case terminal: return "terminal";
+        case phase_count: break;
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,154 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATS_H_SENTRY
+#define STATS_H_SENTRY
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @class Stats
+ * @brief Latency histograms of the game loop phases.
+ * 
+ * Durations are kept in log-linear histograms: every power of two
+ * is split into 16 linear buckets, so the relative error of a
+ * percentile is below 7% from nanoseconds up to hours.
+ * 
+ * Recording is off until Stats::Enable, then a StatTimer costs
+ * two clock_gettime calls and a few increments. While disabled it
+ * is a single branch.
+ */
+class Stats {
+public:
+    /**
+     * @enum phase
+     * @brief Measured parts of a move.
+     * 
+     * @var input    Waiting for a line of input.
+     * @var bot_move Computing the move of the bot.
+     * @var render   ConsoleUI::Print.
+     * @var clear    ConsoleUI::Clear.
+     * @var terminal Terminal mode switches (tcsetattr).
+     */
+    enum phase { input, bot_move, render, clear, terminal, phase_count };
+
+private:
+    enum { 
+        sub_bits = 4,
+        sub_count = 1 << sub_bits,
+        bucket_count = (64 - sub_bits + 1) * sub_count
+    };
+
+    struct histogram {
+        uint64_t count;
+        uint64_t sum;
+        uint64_t min_not;       /**< ~min: zero-filled is "none yet" */
+        uint64_t max;
+        uint64_t bucket[bucket_count];
+    };
+
+    static bool enabled;
+    static histogram hist[phase_count];
+
+public:
+    static void Enable() { enabled = true; }
+    static bool IsEnabled() { return enabled; }
+
+    /**
+     * @brief Monotonic clock in nanoseconds.
+     */
+    static uint64_t Now()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
+    /**
+     * @brief Adds a duration to the histogram of the phase.
+     * 
+     * @param ns Duration in nanoseconds.
+     */
+    static void Record(phase p, uint64_t ns);
+
+    /**
+     * @brief Prints a table of counts and percentiles in microseconds.
+     */
+    static void Print(FILE *f);
+
+    /**
+     * @brief Writes all histograms as JSON.
+     * 
+     * @return false if the file can't be written.
+     */
+    static bool WriteJson(const char *path);
+
+private:
+    /**
+     * @brief Raises the value to x, safe against concurrent updates.
+     */
+    static void AtomicMax(uint64_t &value, uint64_t x);
+
+    /** @return Smallest sample, 0 if there are none */
+    static uint64_t Min(const histogram &h) 
+        { return h.min_not ? ~h.min_not : 0; }
+
+    static int BucketIndex(uint64_t ns);
+    static uint64_t BucketLow(int index);
+    static uint64_t BucketHigh(int index);
+
+    /**
+     * @brief Upper bound of the bucket holding the percentile.
+     * 
+     * @param q Fraction of samples, (0; 1].
+     */
+    static uint64_t Percentile(const histogram &h, double q);
+
+    static const char *Name(phase p);
+};
+
+/**
+ * @class StatTimer
+ * @brief Records the lifetime of the object as a phase duration.
+ */
+class StatTimer {
+private:
+    Stats::phase p;
+    uint64_t start; /**< 0 if recording is disabled */
+
+public:
+    StatTimer(Stats::phase p)
+        : p(p)
+        , start(Stats::IsEnabled() ? Stats::Now() : 0) 
+    {}
+
+    ~StatTimer() 
+    {
+        if (start) { Stats::Record(p, Stats::Now() - start); }
+    }
+
+private:
+    StatTimer(StatTimer &t);
+    void operator=(StatTimer &t);
+};
+
+#endif /* STATS_H_SENTRY */
@@ -0,0 +1,47 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "symmetry.h"
+
+Symmetry::Symmetry(int size)
+{
+    int cells = size * size;
+
+    for (int s = 0; s < count; s++) {
+        for (int half = 0; half < 2; half++) {
+            for (int v = 0; v < 256; v++) {
+                uint16_t img = 0;
+
+                for (int bit = 0; bit < 8; bit++) {
+                    int cell = half * 8 + bit;
+                    if (!(v >> bit & 1) || cell >= cells) { continue; }
+
+                    int r = cell / size, c = cell % size;
+                    if (s & 1) { c = size - 1 - c; }
+                    if (s & 2) { r = size - 1 - r; }
+                    if (s & 4) { int t = r; r = c; c = t; }
+
+                    img |= 1 << (r * size + c);
+                }
+                image[s][half][v] = img;
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMMETRY_H_SENTRY
+#define SYMMETRY_H_SENTRY
+
+#include <stdint.h>
+
+/**
+ * @class Symmetry
+ * @brief The 8 rotations and reflections of a square board of up to 16 cells.
+ * 
+ * A transformation of a mask is two lookups, one per byte.
+ */
+class Symmetry {
+public:
+    enum { count = 8 };
+
+private:
+    uint16_t image[count][2][256];  /**< Images of mask bytes */
+
+public:
+    /**
+     * @param size Side of the board, 4 at most.
+     */
+    explicit Symmetry(int size);
+
+    /**
+     * @brief Image of the mask under the transformation s.
+     * 
+     * @param s 0 is the identity, bit 0 mirrors columns, bit 1 mirrors
+     *          rows, bit 2 transposes.
+     */
+    uint16_t Apply(int s, uint16_t mask) const
+    {
+        return image[s][0][mask & 0xff] | image[s][1][mask >> 8];
+    }
+
+private:
+    Symmetry(Symmetry &s);
+    void operator=(Symmetry &s);
+};
+
+#endif /* SYMMETRY_H_SENTRY */
@@ -20,18 +20,44 @@
 
 #include <unistd.h>
 #include <string.h>
+#include <errno.h>
 
 #include "terminal.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
 
-Terminal::Terminal()
+Terminal *Terminal::active = 0;
+
+Terminal::Terminal(int fd)
+    : fd(fd)
+    , syscalls(0)
+    , leave_text(0)
+    , enter_text(0)
 {
-    tcgetattr(STDIN_FILENO, &origin);
+    struct sigaction sa;
+
+    tcgetattr(fd, &origin);
     memcpy(&modify, &origin, sizeof(termios));
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = OnSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+
+    active = this;
+    sigaction(SIGINT, &sa, &saved_int);
+    sigaction(SIGTSTP, &sa, &saved_tstp);
+    sigaction(SIGCONT, &sa, &saved_cont);
 }
 
 Terminal::~Terminal()
 {
-    tcsetattr(STDIN_FILENO, TCSANOW, &origin);
+    sigaction(SIGINT, &saved_int, 0);
+    sigaction(SIGTSTP, &saved_tstp, 0);
+    sigaction(SIGCONT, &saved_cont, 0);
+    if (active == this) { active = 0; }
+
+    tcsetattr(fd, TCSANOW, &origin);
 }
 
 termios Terminal::GetOrigin() const
@@ -44,33 +70,114 @@ termios Terminal::GetModify() const
     return modify;
 }
 
-void Terminal::DisableICanon(int vtime, int vmin)
+void Terminal::Apply(int mode, int vtime, int vmin)
 {
-    modify.c_lflag &= ~ICANON;
+    StatTimer timer(Stats::terminal);
+    TraceSpan span("Terminal::Apply", "mode", mode);
+    termios target = modify;
+
+    target.c_lflag &= ~(ICANON | ECHO);
+    if (mode & canon) { target.c_lflag |= ICANON; }
+    else {
+        target.c_cc[VTIME] = vtime;
+        target.c_cc[VMIN] = vmin;
+    }
+    if (mode & echo) { target.c_lflag |= ECHO; }
 
-    modify.c_cc[VTIME] = vtime;
-    modify.c_cc[VMIN] = vmin;
+    if (memcmp(&target, &modify, sizeof(termios)) == 0) { return; }
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &modify);
+    modify = target;
+    tcsetattr(fd, TCSANOW, &modify);
+    syscalls++;
 }
 
-void Terminal::EnableICanon()
+void Terminal::SetSignalText(const char *leave, const char *enter)
 {
-    modify.c_lflag |= ICANON;
+    leave_text = leave;
+    enter_text = enter;
+}
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &modify);
+int Terminal::GetMode() const
+{
+    return (modify.c_lflag & ICANON ? canon : 0) | 
+           (modify.c_lflag & ECHO ? echo : 0);
 }
 
-void Terminal::DisableEcho()
+void Terminal::DisableICanon(int vtime, int vmin)
 {
-    modify.c_lflag &= ~ECHO;
+    Apply(GetMode() & ~canon, vtime, vmin);
+}
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &modify);
+void Terminal::EnableICanon()
+{
+    Apply(GetMode() | canon);
+}
+
+void Terminal::DisableEcho()
+{
+    Apply(GetMode() & ~echo, modify.c_cc[VTIME], modify.c_cc[VMIN]);
 }
 
 void Terminal::EnableEcho()
 {
-    modify.c_lflag |= ECHO;
+    Apply(GetMode() | echo, modify.c_cc[VTIME], modify.c_cc[VMIN]);
+}
+
+void Terminal::OnSignal(int sig)
+{
+    int saved_errno = errno;
+    Terminal *term = active;
+    sigset_t set;
+
+    if (sig == SIGCONT) {
+        if (term) { Resume(term); }
+        errno = saved_errno;
+        return;
+    }
+
+    if (term) { 
+        tcsetattr(term->fd, TCSANOW, &term->origin); 
+        if (term->leave_text) { WriteText(term->leave_text); }
+    }
+
+    /* The default action now: terminate or stop */
+    signal(sig, SIG_DFL);
+    sigemptyset(&set);
+    sigaddset(&set, sig);
+    sigprocmask(SIG_UNBLOCK, &set, 0);
+    raise(sig);
+
+    /* Continued after a stop */
+    signal(sig, OnSignal);
+    if (term) { Resume(term); }
+    errno = saved_errno;
+}
+
+void Terminal::Resume(Terminal *term)
+{
+    tcsetattr(term->fd, TCSANOW, &term->modify);
+    if (term->enter_text) {
+        WriteText(term->enter_text);
+        raise(SIGWINCH);
+    }
+}
+
+void Terminal::WriteText(const char *text)
+{
+    ssize_t res = write(STDOUT_FILENO, text, strlen(text));
+    (void)res;
+}
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &modify);
+Terminal::Scope::Scope(Terminal &term, int mode, int vtime, int vmin)
+    : term(term)
+    , saved(term.GetMode())
+    , saved_vtime(term.GetModify().c_cc[VTIME])
+    , saved_vmin(term.GetModify().c_cc[VMIN])
+{
+    term.Apply(mode, vtime, vmin);
+}
+
+Terminal::Scope::~Scope()
+{
+    term.Apply(saved, saved_vtime, saved_vmin);
 }
@@ -22,23 +22,102 @@
 #define TERMINAL_SENTRY
 
 #include <termios.h>
+#include <signal.h>
+#include <unistd.h>
 
 /**
  * @class Terminal
  * @brief Terminal configuration management. 
+ * 
+ * A mode is the set of the ICANON and ECHO bits (with VTIME and VMIN
+ * when ICANON is off). Terminal::Apply computes the target termios and
+ * calls tcsetattr only if it differs from the current one, so a switch
+ * costs one syscall and a repeated one costs none.
+ * 
+ * While the object lives, SIGINT and SIGTSTP restore the original mode
+ * before they take their default action, and SIGCONT sets the current
+ * mode again. The destructor restores the original mode.
  */
 class Terminal {
+public:
+    /**
+     * @enum mode_flag
+     * @brief Bits of a mode for Terminal::Apply.
+     */
+    enum mode_flag { canon = 1, echo = 2, cooked = canon | echo, raw = 0 };
+
+    /**
+     * @class Scope
+     * @brief Sets a mode for the lifetime of the object.
+     * 
+     * The previous mode comes back in the destructor, with one syscall
+     * if they differ.
+     */
+    class Scope {
+    private:
+        Terminal &term;
+        int saved;              /**< Mode before the scope */
+        int saved_vtime, saved_vmin;
+
+    public:
+        Scope(Terminal &term, int mode, int vtime = 0, int vmin = 1);
+        ~Scope();
+
+    private:
+        Scope(Scope &s);
+        void operator=(Scope &s);
+    };
+
 private:
+    int fd;         /**< Terminal being configured */
     termios origin; /**< Configuration before changes */
     termios modify; /**< Configuration after changes */
+    long syscalls;  /**< tcsetattr calls made */
+
+    /** Written to stdout on a stop or interrupt, and on a continue */
+    const char *leave_text, *enter_text;
+
+    /** Handlers before the constructor, restored by the destructor */
+    struct sigaction saved_int, saved_tstp, saved_cont;
+
+    /** The object the signal handlers restore, the last one created */
+    static Terminal *active;
 
 public:
-    Terminal();
+    /**
+     * @param fd Terminal to configure, it is not closed.
+     */
+    explicit Terminal(int fd = STDIN_FILENO);
     ~Terminal();
 
     termios GetOrigin() const;
     termios GetModify() const;
 
+    /**
+     * @brief Switches to the mode with at most one tcsetattr.
+     * 
+     * @param mode Terminal::mode_flag bits.
+     * @param vtime, vmin termios::c_cc values used without ICANON.
+     */
+    void Apply(int mode, int vtime = 0, int vmin = 1);
+
+    /** @return Terminal::mode_flag bits of the current mode */
+    int GetMode() const;
+
+    /**
+     * @brief Output state the signals undo and redo with the mode.
+     * 
+     * E.g. ConsoleUI::screen_off and ConsoleUI::screen_on. After
+     * SIGCONT the process also gets SIGWINCH, as the screen needs
+     * drawing again. The strings aren't copied.
+     * 
+     * @param leave, enter NULL if none.
+     */
+    void SetSignalText(const char *leave, const char *enter);
+
+    /** @return Number of tcsetattr calls made by the object */
+    long GetSyscalls() const { return syscalls; }
+
     /**
      * @brief Setting the ICANON (c_lflag bit) to 0.
      * 
@@ -61,6 +140,23 @@ public:
      * @brief Setting the ECHO (c_lflag bit) to 1.
      */
     void EnableEcho();
+
+private:
+    Terminal(Terminal &t);
+    void operator=(Terminal &t);
+
+    /**
+     * @brief Restores the terminal of Terminal::active, async-signal-safe.
+     */
+    static void OnSignal(int sig);
+
+    /**
+     * @brief Sets the current mode and output state again after a stop.
+     */
+    static void Resume(Terminal *term);
+
+    /** @brief write(2) to stdout, async-signal-safe */
+    static void WriteText(const char *text);
 };
 
 #endif /* TERMINAL_SENTRY */
@@ -0,0 +1,429 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tournament.h"
+#include "../trace/trace.h"
+
+/**
+ * @brief Parses a positive integer option value.
+ * 
+ * @throws const char * if the value is missing or invalid.
+ */
+static int OptionValue(int argc, char **argv, int &i)
+{
+    char *end;
+    long val;
+
+    if (i + 1 >= argc) { throw "Missing option value"; }
+
+    val = strtol(argv[++i], &end, 10);
+    if (*end != '\0' || val < 0) { throw "Bad option value"; }
+
+    return val;
+}
+
+/**
+ * @brief Parses a 64-bit seed option value.
+ * 
+ * @throws const char * if the value is missing or invalid.
+ */
+static uint64_t SeedValue(int argc, char **argv, int &i)
+{
+    char *end;
+    unsigned long long val;
+
+    if (i + 1 >= argc) { throw "Missing option value"; }
+
+    val = strtoull(argv[++i], &end, 10);
+    if (*end != '\0' || argv[i][0] == '-') { throw "Bad option value"; }
+
+    return val;
+}
+
+/**
+ * @brief Expected score for an Elo difference.
+ */
+static double EloScore(double elo)
+{
+    return 1 / (1 + pow(10, -elo / 400));
+}
+
+/**
+ * @brief Elo difference for an expected score.
+ */
+static double ScoreElo(double score)
+{
+    if (score <= 0) { return -INFINITY; }
+    if (score >= 1) { return INFINITY; }
+
+    return 400 * log10(score / (1 - score));
+}
+
+/**
+ * @brief Mean score and its per-game variance of the results.
+ */
+static void ScoreStat(int w, int d, int l, double &score, double &var)
+{
+    int n = w + d + l;
+
+    score = (w + d * 0.5) / n;
+    var = (w * (1 - score) * (1 - score) + d * (0.5 - score) * (0.5 - score)
+           + l * score * score) / n;
+}
+
+Tournament::Tournament(int argc, char **argv)
+    : config_count(0)
+    , pairing_count(0)
+    , mode(round_robin)
+    , size(3)
+    , k(0)
+    , games(100)
+    , opening_plies(1)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , seed(Rng::GetDefaultSeed())
+    , sprt(false)
+    , elo0(0)
+    , elo1(0)
+    , llr(0)
+    , next_task(0)
+    , stopped(0)
+{
+    Bot check("check", 'O');
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--mode") == 0) {
+            if (++i >= argc) { throw "Missing option value"; }
+            if (strcmp(argv[i], "rr") == 0) { mode = round_robin; }
+            else if (strcmp(argv[i], "gauntlet") == 0) { mode = gauntlet; }
+            else { throw "Bad tournament mode"; }
+        }
+        else if (strcmp(argv[i], "--games") == 0) { 
+            games = OptionValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--size") == 0) { 
+            size = OptionValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--k") == 0) { 
+            k = OptionValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--opening") == 0) { 
+            opening_plies = OptionValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--threads") == 0) { 
+            threads = OptionValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--seed") == 0) { 
+            seed = SeedValue(argc, argv, i); 
+        }
+        else if (strcmp(argv[i], "--sprt") == 0) {
+            if (i + 2 >= argc) { throw "Missing option value"; }
+            elo0 = atof(argv[++i]);
+            elo1 = atof(argv[++i]);
+            if (elo0 >= elo1) { throw "SPRT needs elo0 < elo1"; }
+            sprt = true;
+        }
+        else if (argv[i][0] == '-') { throw "Unknown option"; }
+        else {
+            if (config_count == max_configs) { throw "Too many configurations"; }
+            if (!check.SetLevel(argv[i])) { throw "Bad bot configuration"; }
+            config[config_count++] = argv[i];
+        }
+    }
+
+    if (k == 0) { k = size; }
+    if (size < 1 || size > Board::max_size) { throw "Bad board size"; }
+    if (k < 2 || k > size) { throw "Bad line length"; }
+    if (opening_plies > size * size - 1) { throw "Opening is too long"; }
+    if (config_count < 2) { throw "At least two configurations are needed"; }
+    if (sprt && config_count != 2) { throw "SPRT needs two configurations"; }
+    if (threads < 1) { threads = 1; }
+
+    /* Openings this long may all have a win: one is needed for sure */
+    Board probe(size, k);
+    Rng probe_rng(seed);
+    if (!RandomOpening(probe, probe_rng, opening_plies, fallback)) { 
+        throw "Opening is too long"; 
+    }
+
+    /* Both sides of every opening are played */
+    games += games % 2;
+
+    for (int i = 0; i < config_count; i++) {
+        for (int j = i + 1; j < config_count; j++) {
+            if (mode == gauntlet && i != 0) { break; }
+
+            pairing &p = pairings[pairing_count++];
+            p.first = i;
+            p.second = j;
+            p.wins = p.draws = p.losses = 0;
+        }
+    }
+
+    pthread_mutex_init(&lock, 0);
+}
+
+Tournament::~Tournament()
+{
+    pthread_mutex_destroy(&lock);
+}
+
+void Tournament::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s tournament [options] CONFIG CONFIG...\n"
+            "  CONFIG               rules, random, d<depth>, t<ms>, n<nodes>,\n"
+            "                       p<nodes>, table:FILE (tournament only)\n"
+            "  --mode rr|gauntlet   pairings (round robin by default)\n"
+            "  --games N            games per pairing (100)\n"
+            "  --size N --k K       board size and line length (3, 3)\n"
+            "  --opening N          random plies before each game pair (1)\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --seed N             seed of openings and random moves\n"
+            "  --sprt ELO0 ELO1     stop early when SPRT decides\n", name);
+}
+
+int Tournament::Run()
+{
+    pthread_t *tid = new pthread_t[threads];
+    timespec start, end;
+    int started = 0;
+
+    printf("%s, %d configurations, %dx%d k=%d, %d games per pairing, "
+           "%d threads, seed %llu\n", 
+           mode == gauntlet ? "Gauntlet" : "Round robin",
+           config_count, size, size, k, games, threads, 
+           static_cast<unsigned long long>(seed));
+    fflush(stdout);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (; started < threads; started++) {
+        if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+    }
+    if (started == 0) { Worker(this); }
+
+    for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    delete[] tid;
+
+    Report(end.tv_sec - start.tv_sec + (end.tv_nsec - start.tv_nsec) / 1e9);
+    return 0;
+}
+
+void *Tournament::Worker(void *arg)
+{
+    Tournament *t = static_cast<Tournament *>(arg);
+    Bot *bots[max_configs];
+    Board board(t->size, t->k);
+    int task_count = t->pairing_count * (t->games / 2);
+
+    for (int i = 0; i < t->config_count; i++) {
+        bots[i] = new Bot(t->config[i], 'O');
+        bots[i]->SetLevel(t->config[i]);
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&t->lock);
+        if (t->stopped || t->next_task >= task_count) {
+            pthread_mutex_unlock(&t->lock);
+            break;
+        }
+        int task = t->next_task++;
+        pthread_mutex_unlock(&t->lock);
+
+        /* Pairings take turns, so all of them progress evenly */
+        pairing &p = t->pairings[task % t->pairing_count];
+        /* Every task has its own sequence, whatever thread plays it */
+        Rng rng(t->seed + task);
+
+        for (int i = 0; i < t->config_count; i++) { 
+            bots[i]->SetSeed(rng.Next()); 
+        }
+
+        if (!RandomOpening(board, rng, t->opening_plies, 0)) {
+            for (int i = 0; i < t->opening_plies; i++) { 
+                board.Make(t->fallback[i]); 
+            }
+        }
+
+        Bot *side_bot[2] = { bots[p.first], bots[p.second] };
+        int res[2];
+
+        res[0] = t->PlayGame(board, side_bot);
+        side_bot[0] = bots[p.second];
+        side_bot[1] = bots[p.first];
+        res[1] = t->PlayGame(board, side_bot);
+
+        pthread_mutex_lock(&t->lock);
+        for (int g = 0; g < 2; g++) {
+            /* The first configuration plays side g in game g */
+            if (res[g] == -1) { p.draws++; }
+            else if (res[g] == g) { p.wins++; }
+            else { p.losses++; }
+        }
+        if (t->sprt && t->SprtDone()) { t->stopped = 1; }
+        pthread_mutex_unlock(&t->lock);
+    }
+
+    for (int i = 0; i < t->config_count; i++) { delete bots[i]; }
+
+    return 0;
+}
+
+bool Tournament::RandomOpening(Board &board, Rng &rng, int plies, 
+                               int *moves)
+{
+    for (int tries = 0; tries < opening_tries; tries++) {
+        board.Clear();
+        while (board.GetMoveCount() < plies) {
+            int cell = board.RandomFree(rng);
+
+            board.Make(cell);
+            if (board.IsWinAt(cell)) { break; }
+            if (moves) { moves[board.GetMoveCount() - 1] = cell; }
+        }
+
+        if (board.GetMoveCount() == plies && 
+            (plies == 0 || !board.IsWinAt(board.GetLastMove()))) { 
+            return true; 
+        }
+    }
+
+    board.Clear();
+    return false;
+}
+
+int Tournament::PlayGame(Board &board, Bot *side_bot[2]) const
+{
+    TraceSpan span("Tournament::PlayGame");
+    int opening = board.GetMoveCount();
+    int winner = -1;
+
+    while (!board.IsFull()) {
+        int side = board.GetTurn();
+        int cell = side_bot[side]->Choose(board);
+
+        board.Make(cell);
+        if (board.IsWinAt(cell)) {
+            winner = side;
+            break;
+        }
+    }
+
+    while (board.GetMoveCount() > opening) { board.Unmake(); }
+
+    return winner;
+}
+
+bool Tournament::SprtDone()
+{
+    /* Error rates alpha = beta = 0.05 */
+    const double lower = log(0.05 / 0.95);
+    const double upper = log(0.95 / 0.05);
+
+    const pairing &p = pairings[0];
+    int n = p.wins + p.draws + p.losses;
+    double score, var;
+
+    ScoreStat(p.wins, p.draws, p.losses, score, var);
+    if (var <= 0) { return false; }
+
+    /* Normal approximation of the trinomial likelihood ratio */
+    double s0 = EloScore(elo0);
+    double s1 = EloScore(elo1);
+    llr = n * (s1 - s0) * (2 * score - s0 - s1) / (2 * var);
+
+    return llr <= lower || llr >= upper;
+}
+
+void Tournament::Report(double elapsed) const
+{
+    double points[max_configs];
+    int played[max_configs];
+    int total = 0;
+
+    memset(points, 0, sizeof(points));
+    memset(played, 0, sizeof(played));
+
+    printf("\n%-27s %6s %6s %6s %6s %7s %8s %7s\n", "pairing", "games", 
+           "win", "draw", "loss", "score", "elo", "+/-");
+
+    for (int i = 0; i < pairing_count; i++) {
+        const pairing &p = pairings[i];
+        char name[28];
+        int n = p.wins + p.draws + p.losses;
+        double elo, error;
+
+        if (n == 0) { continue; }
+
+        snprintf(name, sizeof(name), "%s vs %s", 
+                 config[p.first], config[p.second]);
+        Elo(p, elo, error);
+
+        printf("%-27s %6d %6d %6d %6d %6.1f%% %8.1f %7.1f\n", name, n, 
+               p.wins, p.draws, p.losses, 
+               100 * (p.wins + p.draws * 0.5) / n, elo, error);
+
+        points[p.first] += p.wins + p.draws * 0.5;
+        points[p.second] += p.losses + p.draws * 0.5;
+        played[p.first] += n;
+        played[p.second] += n;
+        total += n;
+    }
+
+    if (mode == round_robin && config_count > 2) {
+        printf("\n%-27s %6s %7s\n", "standings", "games", "points");
+        for (int i = 0; i < config_count; i++) {
+            printf("%-27s %6d %7.1f\n", config[i], played[i], points[i]);
+        }
+    }
+
+    if (sprt) {
+        printf("\nSPRT elo0 %.1f elo1 %.1f: LLR %.2f [%.2f, %.2f], %s\n", 
+               elo0, elo1, llr, log(0.05 / 0.95), log(0.95 / 0.05),
+               !stopped ? "inconclusive" 
+                        : llr > 0 ? "H1 accepted" : "H0 accepted");
+    }
+
+    printf("\n%d games in %.2f s (%.0f games/s)\n", total, elapsed, 
+           elapsed > 0 ? total / elapsed : 0);
+    fflush(stdout);
+}
+
+void Tournament::Elo(const pairing &p, double &elo, double &error)
+{
+    int n = p.wins + p.draws + p.losses;
+    double score, var;
+
+    ScoreStat(p.wins, p.draws, p.losses, score, var);
+    elo = ScoreElo(score);
+
+    /* 1.96 standard errors of the mean score */
+    double margin = 1.96 * sqrt(var / n);
+    error = (ScoreElo(score + margin) - ScoreElo(score - margin)) / 2;
+}
@@ -0,0 +1,144 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TOURNAMENT_H_SENTRY
+#define TOURNAMENT_H_SENTRY
+
+#include <pthread.h>
+
+#include "../board/board.h"
+#include "../bot/bot.h"
+
+/**
+ * @class Tournament
+ * @brief Matches between bot configurations on all cores.
+ * 
+ * Every game pair shares a random opening and swaps the side that
+ * moves first. For each pairing the win/draw/loss counts and the Elo
+ * difference with a 95% error bar are reported. With two configurations
+ * the match stops early once the SPRT decides between elo0 and elo1.
+ * 
+ * @see Bot::SetLevel for configuration names.
+ */
+class Tournament {
+public:
+    /**
+     * @enum tournament_mode
+     * 
+     * @var round_robin Every configuration plays every other one.
+     * @var gauntlet The first configuration plays all the others.
+     */
+    enum tournament_mode { round_robin, gauntlet };
+
+private:
+    enum { max_configs = 16, max_pairings = max_configs * max_configs / 2 };
+
+    /** Random openings drawn before the fallback one is played */
+    enum { opening_tries = 1000 };
+
+    /**
+     * @brief Results of a pairing from the first configuration's side.
+     */
+    struct pairing {
+        int first;          /**< Index of Tournament::config */
+        int second;
+        int wins, draws, losses;
+    };
+
+    const char *config[max_configs];    /**< Bot::SetLevel specifications */
+    int config_count;
+
+    pairing pairings[max_pairings];
+    int pairing_count;
+
+    tournament_mode mode;
+    int size, k;                /**< Board of every game */
+    int games;                  /**< Games per pairing (even) */
+    int opening_plies;          /**< Random moves before a game */
+    int fallback[Board::max_cells]; /**< An opening without a win */
+    int threads;
+    uint64_t seed;              /**< Openings and random moves */
+
+    bool sprt;                  /**< Early stopping is requested */
+    double elo0, elo1;          /**< SPRT hypotheses */
+    double llr;                 /**< Last log-likelihood ratio */
+
+    pthread_mutex_t lock;       /**< Guards results and next_task */
+    int next_task;              /**< Next game pair to play */
+    int stopped;                /**< SPRT decision is made */
+
+public:
+    /**
+     * @param argc, argv Options after "tournament", see Tournament::Usage.
+     * 
+     * @throws const char * on invalid arguments.
+     */
+    Tournament(int argc, char **argv);
+    ~Tournament();
+
+    /**
+     * @brief Plays all games and prints the report.
+     * 
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Tournament(Tournament &t);
+    void operator=(Tournament &t);
+
+    static void *Worker(void *arg);
+
+    /**
+     * @brief Makes random moves from the empty board until none of
+     *        the plies wins, at most opening_tries times.
+     * 
+     * @param[out] moves The opening, NULL if not needed.
+     * @return false if every try had a win, the board is empty then.
+     */
+    static bool RandomOpening(Board &board, Rng &rng, int plies, int *moves);
+
+    /**
+     * @brief Plays a game between two bots.
+     * 
+     * @param board Position after the opening, restored before return.
+     * @param side_bot Bot playing each side (side 0 moves first).
+     * @return Winning side, -1 for a draw.
+     */
+    int PlayGame(Board &board, Bot *side_bot[2]) const;
+
+    /**
+     * @brief Updates the SPRT state of the only pairing.
+     * 
+     * @return true if one of the hypotheses is accepted.
+     */
+    bool SprtDone();
+
+    void Report(double elapsed) const;
+
+    /**
+     * @brief Elo difference and its 95% error from game results.
+     */
+    static void Elo(const pairing &p, double &elo, double &error);
+};
+
+#endif /* TOURNAMENT_H_SENTRY */
@@ -0,0 +1,129 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+bool Trace::enabled = false;
+const char *Trace::path = 0;
+Trace::buffer *Trace::head = 0;
+int Trace::thread_count = 0;
+__thread Trace::buffer *Trace::local = 0;
+
+void Trace::Enable(const char *path)
+{
+    Trace::path = path;
+    enabled = true;
+}
+
+void Trace::Record(const char *name, uint64_t start, uint64_t end,
+                   const char *arg_name, long long arg)
+{
+    buffer *b = LocalBuffer();
+    if (!b) { return; }
+
+    if (b->count == buffer_events) {
+        b->dropped++;
+        return;
+    }
+
+    event &e = b->events[b->count];
+    e.name = name;
+    e.arg_name = arg_name;
+    e.arg = arg;
+    e.start = start;
+    e.duration = end - start;
+
+    /* The event is complete before it is counted */
+    __atomic_store_n(&b->count, b->count + 1, __ATOMIC_RELEASE);
+}
+
+bool Trace::Flush()
+{
+    if (!enabled) { return true; }
+
+    FILE *f = fopen(path, "w");
+    if (!f) { return false; }
+
+    buffer *list = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    int pid = getpid();
+    bool first = true;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    for (buffer *b = list; b; b = b->next) {
+        unsigned count = __atomic_load_n(&b->count, __ATOMIC_ACQUIRE);
+
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+                "\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", 
+                first ? "" : ",\n", pid, b->tid, b->tid);
+        first = false;
+
+        for (unsigned i = 0; i < count; i++) {
+            const event &e = b->events[i];
+
+            /* Microseconds with nanosecond precision */
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,"
+                    "\"tid\":%d,\"ts\":%llu.%03u,\"dur\":%llu.%03u",
+                    e.name, pid, b->tid,
+                    static_cast<unsigned long long>(e.start / 1000),
+                    static_cast<unsigned>(e.start % 1000),
+                    static_cast<unsigned long long>(e.duration / 1000),
+                    static_cast<unsigned>(e.duration % 1000));
+
+            if (e.arg_name) {
+                fprintf(f, ",\"args\":{\"%s\":%lld}", e.arg_name, e.arg);
+            }
+            fputc('}', f);
+        }
+
+        if (b->dropped) {
+            fprintf(stderr, "trace: thread %d dropped %u spans\n", 
+                    b->tid, b->dropped);
+        }
+    }
+
+    fprintf(f, "\n]}\n");
+
+    return fclose(f) == 0;
+}
+
+Trace::buffer *Trace::LocalBuffer()
+{
+    if (local) { return local; }
+
+    buffer *b = static_cast<buffer *>(malloc(sizeof(buffer)));
+    if (!b) { return 0; }
+
+    b->count = 0;
+    b->dropped = 0;
+    b->tid = __atomic_add_fetch(&thread_count, 1, __ATOMIC_RELAXED);
+
+    /* Lock-free push to the list of buffers */
+    b->next = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&head, &b->next, b, true, 
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    local = b;
+    return b;
+}
@@ -0,0 +1,128 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACE_H_SENTRY
+#define TRACE_H_SENTRY
+
+#include <stdint.h>
+
+#include "../stats/stats.h"
+
+/**
+ * @class Trace
+ * @brief Recording of spans in the Chrome trace-event format.
+ * 
+ * Every thread writes into its own buffer, so recording takes no locks.
+ * A buffer is registered once in a lock-free list when the thread
+ * records its first span. When a buffer is full, further spans of the
+ * thread are dropped and counted. Trace::Flush writes all buffers as
+ * JSON that loads in chrome://tracing and Perfetto.
+ * 
+ * @see TraceSpan
+ */
+class Trace {
+private:
+    enum { buffer_events = 1 << 16 };
+
+    struct event {
+        const char *name;       /**< String literal */
+        const char *arg_name;   /**< NULL if there is no argument */
+        long long arg;
+        uint64_t start;         /**< Stats::Now */
+        uint64_t duration;
+    };
+
+    struct buffer {
+        buffer *next;
+        int tid;                /**< Sequential thread number */
+        unsigned count;         /**< Published events */
+        unsigned dropped;       /**< Events lost to overflow */
+        event events[buffer_events];
+    };
+
+    static bool enabled;
+    static const char *path;
+    static buffer *head;        /**< All buffers, newest first */
+    static int thread_count;
+    static __thread buffer *local;
+
+public:
+    /**
+     * @brief Starts recording.
+     * 
+     * @param path Output file of Trace::Flush.
+     */
+    static void Enable(const char *path);
+    static bool IsEnabled() { return enabled; }
+
+    /**
+     * @brief Adds a completed span to the buffer of the calling thread.
+     */
+    static void Record(const char *name, uint64_t start, uint64_t end,
+                       const char *arg_name = 0, long long arg = 0);
+
+    /**
+     * @brief Writes all recorded spans.
+     * 
+     * @return false if the file can't be written.
+     * 
+     * @note Call after all recording threads are joined.
+     */
+    static bool Flush();
+
+private:
+    static buffer *LocalBuffer();
+};
+
+/**
+ * @class TraceSpan
+ * @brief Records the lifetime of the object as a span.
+ */
+class TraceSpan {
+private:
+    const char *name;
+    const char *arg_name;
+    long long arg;
+    uint64_t start; /**< 0 if recording is disabled */
+
+public:
+    /**
+     * @param name String literal shown as the span name.
+     * @param arg_name Name of an optional argument (string literal).
+     * @param arg Value of the argument.
+     */
+    TraceSpan(const char *name, const char *arg_name = 0, long long arg = 0)
+        : name(name)
+        , arg_name(arg_name)
+        , arg(arg)
+        , start(Trace::IsEnabled() ? Stats::Now() : 0)
+    {}
+
+    ~TraceSpan()
+    {
+        if (start) { Trace::Record(name, start, Stats::Now(), arg_name, arg); }
+    }
+
+private:
+    TraceSpan(TraceSpan &s);
+    void operator=(TraceSpan &s);
+};
+
+#endif /* TRACE_H_SENTRY */
@@ -0,0 +1,141 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "ultimate.h"
+
+bool Ultimate::is_line[full_mask + 1];
+pthread_once_t Ultimate::tables_once = PTHREAD_ONCE_INIT;
+
+Ultimate::Ultimate()
+{
+    pthread_once(&tables_once, BuildTables);
+
+    Clear();
+}
+
+void Ultimate::BuildTables()
+{
+    static const uint16_t lines[8] = { 
+        0007, 0070, 0700,           /* rows */
+        0111, 0222, 0444,           /* columns */
+        0421, 0124                  /* diagonals */
+    };
+
+    for (int m = 0; m <= full_mask; m++) {
+        is_line[m] = false;
+        for (int l = 0; l < 8; l++) {
+            if ((m & lines[l]) == lines[l]) { is_line[m] = true; }
+        }
+    }
+}
+
+void Ultimate::Clear()
+{
+    memset(local, 0, sizeof(local));
+    meta[0] = meta[1] = 0;
+    closed = 0;
+    target = any_board;
+    move_count = 0;
+}
+
+int Ultimate::GetMark(int cell) const
+{
+    int board = cell / 9, bit = 1 << cell % 9;
+
+    if (local[0][board] & bit) { return 1; }
+    if (local[1][board] & bit) { return 2; }
+
+    return 0;
+}
+
+int Ultimate::GenerateMoves(int *moves) const
+{
+    int boards, count = 0;
+
+    if (IsWon()) { return 0; }
+
+    boards = target != any_board ? 1 << target : ~closed & full_mask;
+    while (boards) {
+        int board = __builtin_ctz(boards);
+        int free = ~(local[0][board] | local[1][board]) & full_mask;
+
+        while (free) {
+            moves[count++] = board * 9 + __builtin_ctz(free);
+            free &= free - 1;
+        }
+        boards &= boards - 1;
+    }
+
+    return count;
+}
+
+void Ultimate::Make(int cell)
+{
+    int side = GetTurn(), board = cell / 9, c = cell % 9;
+    uint16_t &own = local[side][board];
+
+    own |= 1 << c;
+    if (is_line[own]) {
+        meta[side] |= 1 << board;
+        closed |= 1 << board;
+    }
+    else if ((own | local[!side][board]) == full_mask) {
+        closed |= 1 << board;
+    }
+
+    target_history[move_count] = target;
+    history[move_count++] = cell;
+    target = closed >> c & 1 ? any_board : c;
+}
+
+void Ultimate::Unmake()
+{
+    int cell = history[--move_count];
+    int side = GetTurn(), board = cell / 9;
+
+    /* The board was open before the move */
+    local[side][board] &= ~(1 << cell % 9);
+    meta[side] &= ~(1 << board);
+    closed &= ~(1 << board);
+    target = target_history[move_count];
+}
+
+long long Ultimate::Perft(int depth)
+{
+    int moves[cell_count];
+    int count;
+    long long nodes = 0;
+
+    if (depth == 0) { return 1; }
+
+    count = GenerateMoves(moves);
+    if (count == 0) { return 1; }
+    if (depth == 1) { return count; }
+
+    for (int i = 0; i < count; i++) {
+        Make(moves[i]);
+        nodes += Perft(depth - 1);
+        Unmake();
+    }
+
+    return nodes;
+}
@@ -0,0 +1,134 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ULTIMATE_H_SENTRY
+#define ULTIMATE_H_SENTRY
+
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @class Ultimate
+ * @brief Ultimate tic-tac-toe position on bitboards.
+ * 
+ * Nine local 3x3 boards make a 3x3 meta-board. A move in cell c of a
+ * local board sends the opponent to local board c, unless that board
+ * is won or full: then any open board may be played. Winning a local
+ * board takes its cell of the meta-board, three of them in a line win
+ * the game.
+ * 
+ * Every local board is a 9-bit mask per side, and so are the won and
+ * the closed boards of the meta-board. Legal moves, local wins and
+ * the meta win are mask operations and lookups in a 512-entry table.
+ * Cells are numbered board * 9 + local cell, both in row-major order.
+ */
+class Ultimate {
+public:
+    enum { 
+        board_count = 9, 
+        cell_count = board_count * 9,
+        full_mask = 0x1ff,
+        any_board = -1              /**< Ultimate::GetTarget: free choice */
+    };
+
+private:
+    /** Masks of 9 cells that contain three in a line */
+    static bool is_line[full_mask + 1];
+    static pthread_once_t tables_once;
+
+    uint16_t local[2][board_count];
+    uint16_t meta[2];               /**< Won boards by side */
+    uint16_t closed;                /**< Won or full boards */
+    int target;                     /**< Board to play, Ultimate::any_board */
+
+    int history[cell_count];
+    int8_t target_history[cell_count];  /**< Ultimate::target before a ply */
+    int move_count;
+
+public:
+    Ultimate();
+
+    void Clear();
+
+    int GetTurn() const { return move_count & 1; }
+    int GetMoveCount() const { return move_count; }
+    int GetLastMove() const 
+        { return move_count ? history[move_count - 1] : -1; }
+    int GetMove(int i) const { return history[i]; }
+    int GetTarget() const { return target; }
+
+    /** @return 0 if free, 1 or 2 for a mark of side 0 or 1 */
+    int GetMark(int cell) const;
+
+    /** @return Mask of the local boards won by the side */
+    int GetWonBoards(int side) const { return meta[side]; }
+
+    /**
+     * @brief Mask of free cells of the board that may be played now.
+     */
+    int GetMoveMask(int board) const
+    {
+        if (target != any_board ? board != target : closed >> board & 1) {
+            return 0;
+        }
+        return ~(local[0][board] | local[1][board]) & full_mask;
+    }
+
+    bool IsLegal(int cell) const { return GetMoveMask(cell / 9) >> cell % 9 & 1; }
+
+    /**
+     * @brief Fills the legal moves in ascending order.
+     * 
+     * @return Number of moves, 0 if the game is over.
+     */
+    int GenerateMoves(int *moves) const;
+
+    /** @return The last move won the meta-board */
+    bool IsWon() const 
+        { return move_count && is_line[meta[!GetTurn()]]; }
+
+    /** @return All boards are closed and nobody won */
+    bool IsDrawn() const { return closed == full_mask && !IsWon(); }
+
+    /**
+     * @brief Places a mark of the side to move, the move must be legal.
+     */
+    void Make(int cell);
+
+    /**
+     * @brief Takes back the last move.
+     */
+    void Unmake();
+
+    /**
+     * @brief Counts the move sequences of the given length.
+     * 
+     * Finished games are leaves even if they are shorter.
+     */
+    long long Perft(int depth);
+
+private:
+    Ultimate(Ultimate &u);
+    void operator=(Ultimate &u);
+
+    static void BuildTables();
+};
+
+#endif /* ULTIMATE_H_SENTRY */
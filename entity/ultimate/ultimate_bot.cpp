@@ -0,0 +1,175 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+
+#include "ultimate_bot.h"
+#include "../stats/stats.h"
+#include "../trace/trace.h"
+
+UltimateBot::UltimateBot()
+    : pool(new node[pool_size])
+    , used(0)
+    , playouts(0)
+{}
+
+UltimateBot::~UltimateBot()
+{
+    delete[] pool;
+}
+
+int UltimateBot::Choose(Ultimate &game, long movetime)
+{
+    TraceSpan span("UltimateBot::Choose");
+    uint64_t deadline = Stats::Now() + movetime * 1000000ULL;
+    int path[Ultimate::cell_count + 1];
+    int best = -1, best_visits = -1;
+    node &root = pool[0];
+
+    playouts = 0;
+    used = 1;
+    root.first_child = 0;
+    root.child_count = 0;
+    root.visits = 0;
+    root.score = 0;
+
+    if (!Expand(game, 0)) { return -1; }
+    if (root.child_count == 1) { return pool[root.first_child].move; }
+
+    while ((playouts & 63) != 0 || Stats::Now() < deadline) {
+        int depth = 0, index = 0, winner;
+
+        path[depth++] = 0;
+        while (pool[index].child_count) {
+            index = Select(index);
+            game.Make(pool[index].move);
+            path[depth++] = index;
+        }
+
+        if (pool[index].visits > 0 && Expand(game, index)) {
+            index = pool[index].first_child;
+            game.Make(pool[index].move);
+            path[depth++] = index;
+        }
+
+        winner = Playout(game);
+        playouts++;
+
+        /* Down the path the side that made the move alternates */
+        for (int i = depth - 1; i >= 0; i--) {
+            node &n = pool[path[i]];
+
+            n.visits++;
+            if (winner == -1) { n.score += 0.5f; }
+            else if (i > 0 && winner == !game.GetTurn()) { n.score += 1; }
+
+            if (i > 0) { game.Unmake(); }
+        }
+    }
+
+    for (int i = 0; i < root.child_count; i++) {
+        const node &n = pool[root.first_child + i];
+        if (n.visits > best_visits) {
+            best_visits = n.visits;
+            best = n.move;
+        }
+    }
+
+    return best;
+}
+
+int UltimateBot::GetRootRates(int *moves, float *rates) const
+{
+    const node &root = pool[0];
+
+    if (used == 0) { return 0; }
+
+    for (int i = 0; i < root.child_count; i++) {
+        const node &n = pool[root.first_child + i];
+
+        moves[i] = n.move;
+        rates[i] = n.visits ? n.score / n.visits : -1;
+    }
+
+    return root.child_count;
+}
+
+bool UltimateBot::Expand(const Ultimate &game, int index)
+{
+    int moves[Ultimate::cell_count];
+    int count = game.GenerateMoves(moves);
+
+    if (count == 0 || used + count > pool_size) { return false; }
+
+    pool[index].first_child = used;
+    pool[index].child_count = count;
+
+    for (int i = 0; i < count; i++) {
+        node &n = pool[used++];
+
+        n.first_child = 0;
+        n.child_count = 0;
+        n.move = moves[i];
+        n.visits = 0;
+        n.score = 0;
+    }
+
+    return true;
+}
+
+int UltimateBot::Select(int index) const
+{
+    const node &parent = pool[index];
+    float log_n = logf(parent.visits + 1);
+    float best_value = -1;
+    int best = parent.first_child;
+
+    for (int i = 0; i < parent.child_count; i++) {
+        const node &n = pool[parent.first_child + i];
+        float value;
+
+        /* Unvisited moves go first */
+        if (n.visits == 0) { return parent.first_child + i; }
+
+        value = n.score / n.visits + 1.4f * sqrtf(log_n / n.visits);
+        if (value > best_value) {
+            best_value = value;
+            best = parent.first_child + i;
+        }
+    }
+
+    return best;
+}
+
+int UltimateBot::Playout(Ultimate &game)
+{
+    int moves[Ultimate::cell_count];
+    int plies = 0, count, winner;
+
+    while ((count = game.GenerateMoves(moves)) != 0) {
+        game.Make(moves[rng.Below(count)]);
+        plies++;
+    }
+
+    winner = game.IsWon() ? !game.GetTurn() : -1;
+    while (plies--) { game.Unmake(); }
+
+    return winner;
+}
@@ -0,0 +1,116 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ULTIMATE_BOT_H_SENTRY
+#define ULTIMATE_BOT_H_SENTRY
+
+#include <stdint.h>
+
+#include "ultimate.h"
+#include "../rng/rng.h"
+
+/**
+ * @class UltimateBot
+ * @brief Monte Carlo tree search for ultimate tic-tac-toe.
+ * 
+ * Every iteration walks down the tree by UCB1, expands a leaf with all
+ * its legal moves and plays the rest of the game at random. The moves
+ * are made and taken back on the same position, so nothing is copied.
+ * The tree lives in a fixed pool of nodes that is reused by every
+ * UltimateBot::Choose; when it's full the search stops growing the tree
+ * and only runs playouts.
+ */
+class UltimateBot {
+private:
+    enum { pool_size = 1 << 20 };
+
+    /**
+     * @struct node
+     * @brief A move in the tree and its playout statistics.
+     * 
+     * @var score Wins of the side that made the move, draws count half.
+     */
+    struct node {
+        int first_child;            /**< Index in the pool, 0 if none */
+        uint8_t child_count;
+        int8_t move;
+        int visits;
+        float score;
+    };
+
+    node *pool;
+    int used;                       /**< Nodes of the current tree */
+    Rng rng;
+    long long playouts;             /**< Of the last UltimateBot::Choose */
+
+public:
+    UltimateBot();
+    ~UltimateBot();
+
+    /**
+     * @brief Chooses a move for the side to move.
+     * 
+     * @param game Position, restored before return.
+     * @param movetime Milliseconds of the search.
+     * 
+     * @return Selected cell, -1 if the game is over.
+     */
+    int Choose(Ultimate &game, long movetime);
+
+    /**
+     * @brief Statistics of the root moves of the last search.
+     * 
+     * @param[out] moves Cells of the moves.
+     * @param[out] rates Share of the playouts the side to move won
+     *                   after each, draws count half; -1 if unvisited.
+     * 
+     * @return Number of the moves.
+     */
+    int GetRootRates(int *moves, float *rates) const;
+
+    long long GetPlayouts() const { return playouts; }
+
+    void SetSeed(uint64_t seed) { rng.Seed(seed); }
+
+private:
+    UltimateBot(UltimateBot &b);
+    void operator=(UltimateBot &b);
+
+    /**
+     * @brief Adds the legal moves of the position as children.
+     * 
+     * @return false if the pool is full or the game is over.
+     */
+    bool Expand(const Ultimate &game, int index);
+
+    /**
+     * @brief Child of the node with the best UCB1 value.
+     */
+    int Select(int index) const;
+
+    /**
+     * @brief Finishes the game with random moves and takes them back.
+     * 
+     * @return Winning side, -1 for a draw.
+     */
+    int Playout(Ultimate &game);
+};
+
+#endif /* ULTIMATE_BOT_H_SENTRY */
@@ -0,0 +1,216 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "value_table.h"
+
+static const char value_magic[8] = "TTTVAL1";
+
+ValueTable::ValueTable(const Board &rules)
+    : size(rules.GetSize())
+    , k(rules.GetK())
+    , cells(rules.GetCellCount())
+    , sym(0)
+    , base(0)
+    , base_len(0)
+    , mapped(false)
+    , values(0)
+{
+    if (cells > max_cells) { throw "Board is too large"; }
+
+    Init();
+
+    base_len = sizeof(header) + code_count * sizeof(int16_t);
+    base = new char[base_len];
+    memset(base, 0, base_len);
+
+    header *h = reinterpret_cast<header *>(base);
+    memcpy(h->magic, value_magic, sizeof(value_magic));
+    h->size = size;
+    h->k = k;
+
+    values = reinterpret_cast<int16_t *>(base + sizeof(header));
+}
+
+ValueTable::ValueTable(const char *path, bool writable)
+    : size(0)
+    , k(0)
+    , cells(0)
+    , sym(0)
+    , base(0)
+    , base_len(0)
+    , mapped(true)
+    , values(0)
+{
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd == -1) { throw "Can't open the value table"; }
+    if (fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(header)) {
+        close(fd);
+        throw "Invalid value table";
+    }
+
+    base_len = st.st_size;
+    void *map = writable 
+              ? mmap(0, base_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+              : mmap(0, base_len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { throw "Can't map the value table"; }
+    base = static_cast<char *>(map);
+
+    const header *h = reinterpret_cast<const header *>(base);
+    size = h->size;
+    k = h->k;
+    cells = size * size;
+
+    if (memcmp(h->magic, value_magic, sizeof(value_magic)) != 0 
+        || size < 1 || cells > max_cells || k < 1 || k > size) 
+    {
+        munmap(base, base_len);
+        throw "Invalid value table";
+    }
+
+    Init();
+
+    if (base_len != sizeof(header) + code_count * sizeof(int16_t)) {
+        delete sym;
+        munmap(base, base_len);
+        throw "Invalid value table";
+    }
+
+    values = reinterpret_cast<int16_t *>(base + sizeof(header));
+}
+
+ValueTable::~ValueTable()
+{
+    if (mapped) { munmap(base, base_len); }
+    else { delete[] base; }
+
+    delete sym;
+}
+
+void ValueTable::Init()
+{
+    uint32_t pow3[max_cells];
+
+    code_count = 1;
+    for (int i = 0; i < cells; i++) {
+        pow3[i] = code_count;
+        code_count *= 3;
+    }
+    for (int i = cells; i < max_cells; i++) { pow3[i] = 0; }
+
+    for (int half = 0; half < 2; half++) {
+        for (int v = 0; v < 256; v++) {
+            uint32_t code = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                if (v >> bit & 1) { code += pow3[half * 8 + bit]; }
+            }
+            byte_code[half][v] = code;
+        }
+    }
+
+    sym = new Symmetry(size);
+}
+
+bool ValueTable::Save(const char *path) const
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    size_t done = 0;
+
+    if (fd == -1) { return false; }
+
+    while (done < base_len) {
+        ssize_t n = write(fd, base + done, base_len - done);
+        if (n <= 0) { break; }
+        done += n;
+    }
+
+    return close(fd) == 0 && done == base_len;
+}
+
+uint64_t ValueTable::GetEpisodes() const
+{
+    return reinterpret_cast<const header *>(base)->episodes;
+}
+
+void ValueTable::AddEpisodes(uint64_t n)
+{
+    __atomic_fetch_add(&reinterpret_cast<header *>(base)->episodes, n, 
+                       __ATOMIC_RELAXED);
+}
+
+uint32_t ValueTable::Canonical(const Board &board) const
+{
+    uint16_t m0 = board.GetMask(0), m1 = board.GetMask(1);
+    uint32_t best = code_count;
+
+    for (int s = 0; s < Symmetry::count; s++) {
+        uint32_t code = Code(sym->Apply(s, m0), sym->Apply(s, m1));
+        if (code < best) { best = code; }
+    }
+
+    return best;
+}
+
+void ValueTable::Update(uint32_t code, int target, double alpha)
+{
+    int v = Get(code);
+    double step = (target - v) * alpha;
+
+    v += static_cast<int>(step < 0 ? step - 0.5 : step + 0.5);
+    __atomic_store_n(&values[code], static_cast<int16_t>(v), __ATOMIC_RELAXED);
+}
+
+int ValueTable::Greedy(Board &board, Rng *rng, int &value) const
+{
+    uint64_t free = board.GetFree();
+    int best = -1, ties = 0;
+
+    value = -one - 1;
+
+    for (; free; free &= free - 1) {
+        int cell = __builtin_ctzll(free);
+        int v;
+
+        board.Make(cell);
+        if (board.IsWinAt(cell)) { v = one; }
+        else if (board.IsFull()) { v = 0; }
+        else { v = Get(Canonical(board)); }
+        board.Unmake();
+
+        if (v > value) {
+            value = v;
+            best = cell;
+            ties = 1;
+        }
+        else if (v == value && rng && rng->Below(++ties) == 0) { 
+            best = cell; 
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,152 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALUE_TABLE_H_SENTRY
+#define VALUE_TABLE_H_SENTRY
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../board/board.h"
+#include "../rng/rng.h"
+#include "../symmetry/symmetry.h"
+
+/**
+ * @class ValueTable
+ * @brief Learned values of positions, up to symmetry.
+ * 
+ * A value belongs to the position after a move and is the expected
+ * result for the side that made it, from -ValueTable::one (loss) to
+ * ValueTable::one (win). Positions are indexed by the smallest base 3
+ * code among their 8 images (see Solved for the encoding), so the
+ * table is dense and a lookup is O(1).
+ * 
+ * File format (native byte order): ValueTable::header, then an int16
+ * value for each of the 3^cells codes. A loaded table is a read-only
+ * mapping of the file, so bots using the same file share its pages.
+ * 
+ * @note Boards of up to 16 cells.
+ */
+class ValueTable {
+public:
+    enum { one = 16384, max_cells = 16 };
+
+private:
+    struct header {
+        char magic[8];                  /**< "TTTVAL1" */
+        uint32_t size;
+        uint32_t k;
+        uint64_t episodes;              /**< Training games so far */
+        uint64_t reserved;
+    };
+
+    int size, k, cells;
+    uint32_t code_count;                /**< 3^cells */
+    uint32_t byte_code[2][256];         /**< Base 3 codes of mask bytes */
+    Symmetry *sym;
+
+    char *base;                         /**< Header and values */
+    size_t base_len;
+    bool mapped;                        /**< base is a file mapping */
+    int16_t *values;
+
+public:
+    /**
+     * @brief Zero table for training.
+     * 
+     * @throws const char * if the board is too large.
+     */
+    explicit ValueTable(const Board &rules);
+
+    /**
+     * @brief Maps a table saved by ValueTable::Save.
+     * 
+     * @param writable Private copy-on-write mapping, to resume training.
+     * 
+     * @throws const char * if the file can't be read or is invalid.
+     */
+    explicit ValueTable(const char *path, bool writable = false);
+    ~ValueTable();
+
+    /**
+     * @return false if the file can't be written.
+     */
+    bool Save(const char *path) const;
+
+    bool Matches(const Board &board) const 
+    { 
+        return board.GetSize() == size && board.GetK() == k; 
+    }
+
+    size_t GetBytes() const { return base_len; }
+    uint64_t GetEpisodes() const;
+    void AddEpisodes(uint64_t n);
+
+    /**
+     * @brief Code of the position shared by all its images.
+     */
+    uint32_t Canonical(const Board &board) const;
+
+    int Get(uint32_t code) const 
+    { 
+        return __atomic_load_n(&values[code], __ATOMIC_RELAXED); 
+    }
+
+    /**
+     * @brief Moves the value toward the target by the step alpha.
+     * 
+     * Threads update the table without locks: a racing update of the
+     * same position can be lost, which only slows the learning a bit.
+     * 
+     * @note Not for read-only mappings.
+     */
+    void Update(uint32_t code, int target, double alpha);
+
+    /**
+     * @brief The move with the best value for the side to move.
+     * 
+     * A move that wins is worth ValueTable::one and a move that
+     * fills the board is a draw, other moves are looked up.
+     * 
+     * @param board Position with free cells, restored before return.
+     * @param rng Breaks ties at random, can be NULL (first best cell).
+     * @param[out] value Value of the move.
+     * 
+     * @return Selected cell.
+     */
+    int Greedy(Board &board, Rng *rng, int &value) const;
+
+private:
+    ValueTable(ValueTable &t);
+    void operator=(ValueTable &t);
+
+    /**
+     * @brief Fills the lookup tables after size and k are known.
+     */
+    void Init();
+
+    uint32_t Code(uint16_t m0, uint16_t m1) const
+    {
+        return byte_code[0][m0 & 0xff] + byte_code[1][m0 >> 8]
+             + 2 * (byte_code[0][m1 & 0xff] + byte_code[1][m1 >> 8]);
+    }
+};
+
+#endif /* VALUE_TABLE_H_SENTRY */
@@ -0,0 +1,86 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "classic_variant.h"
+
+ClassicVariant::ClassicVariant()
+    : board(3, 3)
+    , bot("><[O_O]><", 'O')
+{}
+
+void ClassicVariant::ToGrid(int cell, int &row, int &col) const
+{
+    row = cell / board.GetSize();
+    col = cell % board.GetSize();
+}
+
+Variant::move_status ClassicVariant::ParseMove(const char *str, int &cell) const
+{
+    int rowi, coli;
+
+    if (sscanf(str, "%d %d", &rowi, &coli) != 2) { return invalid; }
+    if (rowi < 0 || rowi >= board.GetSize() || coli < 0 || coli >= board.GetSize()) {
+        return out_of_range;
+    }
+
+    cell = rowi * board.GetSize() + coli;
+    if (!board.IsFree(cell)) { return busy; }
+
+    return valid;
+}
+
+void ClassicVariant::FormatMove(int cell, char *buff, size_t size) const
+{
+    snprintf(buff, size, "%d %d", cell / board.GetSize(), cell % board.GetSize());
+}
+
+Variant::result ClassicVariant::GetResult() const
+{
+    int last = board.GetLastMove();
+
+    if (last != -1 && board.IsWinAt(last)) { return won; }
+    if (board.IsFull()) { return drawn; }
+
+    return going;
+}
+
+bool ClassicVariant::Analyze(char *hints, long movetime)
+{
+    int scores[Board::max_cells];
+    int cells = board.GetCellCount();
+    int depth;
+
+    memset(hints, 0, cells);
+    depth = bot.Analyze(board, movetime, scores);
+    if (depth == 0) { return false; }
+
+    for (int i = 0; i < cells; i++) {
+        if (!board.IsFree(i)) { continue; }
+
+        /* Searched to the end: a zero is a draw, not an estimate */
+        if (depth >= cells - board.GetMoveCount() && scores[i] == 0) { hints[i] = 'd'; }
+        else { hints[i] = ScoreHint(scores[i], Bot::score_proven); }
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLASSIC_VARIANT_H_SENTRY
+#define CLASSIC_VARIANT_H_SENTRY
+
+#include "variant.h"
+#include "../board/board.h"
+#include "../bot/bot.h"
+
+/**
+ * @class ClassicVariant
+ * @brief 3x3 tic-tac-toe with the rules bot.
+ */
+class ClassicVariant : public Variant {
+private:
+    Board board;
+    Bot bot;
+
+public:
+    ClassicVariant();
+
+    const char *GetTitle() const { return "Tic Tac Toe"; }
+    int GetRows() const { return board.GetSize(); }
+    int GetCols() const { return board.GetSize(); }
+    void ToGrid(int cell, int &row, int &col) const;
+    move_status ParseMove(const char *str, int &cell) const;
+    void FormatMove(int cell, char *buff, size_t size) const;
+    void Make(int cell) { board.Make(cell); }
+    void Unmake() { board.Unmake(); }
+    int GetMoveCount() const { return board.GetMoveCount(); }
+    int GetLastMove() const { return board.GetLastMove(); }
+    int GetMove(int i) const { return board.GetMove(i); }
+    result GetResult() const;
+    int BotMove() { return bot.Choose(board); }
+    void Clear() { board.Clear(); }
+    bool Analyze(char *hints, long movetime);
+
+private:
+    ClassicVariant(ClassicVariant &v);
+    void operator=(ClassicVariant &v);
+};
+
+#endif /* CLASSIC_VARIANT_H_SENTRY */
@@ -0,0 +1,57 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+
+#include "gomoku_variant.h"
+
+void GomokuVariant::ToGrid(int cell, int &row, int &col) const
+{
+    row = cell / Gomoku::size;
+    col = cell % Gomoku::size;
+}
+
+Variant::move_status GomokuVariant::ParseMove(const char *str, int &cell) const
+{
+    int rowi, coli;
+
+    if (sscanf(str, "%d %d", &rowi, &coli) != 2) { return invalid; }
+    if (rowi < 0 || rowi >= Gomoku::size || coli < 0 || coli >= Gomoku::size) {
+        return out_of_range;
+    }
+
+    cell = rowi * Gomoku::size + coli;
+    if (!game.IsFree(cell)) { return busy; }
+
+    return valid;
+}
+
+void GomokuVariant::FormatMove(int cell, char *buff, size_t size) const
+{
+    snprintf(buff, size, "%d %d", cell / Gomoku::size, cell % Gomoku::size);
+}
+
+Variant::result GomokuVariant::GetResult() const
+{
+    if (game.IsWon()) { return won; }
+    if (game.IsFull()) { return drawn; }
+
+    return going;
+}
@@ -0,0 +1,62 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GOMOKU_VARIANT_H_SENTRY
+#define GOMOKU_VARIANT_H_SENTRY
+
+#include "variant.h"
+#include "../gomoku/gomoku.h"
+#include "../gomoku/gomoku_bot.h"
+
+/**
+ * @class GomokuVariant
+ * @brief Five in a row on 15x15, the bot thinks for 100 ms.
+ */
+class GomokuVariant : public Variant {
+private:
+    enum { bot_movetime = 100 };
+
+    Gomoku game;
+    GomokuBot bot;
+
+public:
+    GomokuVariant() {}
+
+    const char *GetTitle() const { return "Gomoku"; }
+    int GetRows() const { return Gomoku::size; }
+    int GetCols() const { return Gomoku::size; }
+    void ToGrid(int cell, int &row, int &col) const;
+    move_status ParseMove(const char *str, int &cell) const;
+    void FormatMove(int cell, char *buff, size_t size) const;
+    void Make(int cell) { game.Make(cell); }
+    void Unmake() { game.Unmake(); }
+    int GetMoveCount() const { return game.GetMoveCount(); }
+    int GetLastMove() const { return game.GetLastMove(); }
+    int GetMove(int i) const { return game.GetMove(i); }
+    result GetResult() const;
+    int BotMove() { return bot.Choose(game, bot_movetime); }
+    void Clear() { game.Clear(); }
+
+private:
+    GomokuVariant(GomokuVariant &v);
+    void operator=(GomokuVariant &v);
+};
+
+#endif /* GOMOKU_VARIANT_H_SENTRY */
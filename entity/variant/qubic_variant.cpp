@@ -0,0 +1,74 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "qubic_variant.h"
+
+void QubicVariant::ToGrid(int cell, int &row, int &col) const
+{
+    row = cell / Qubic::size % Qubic::size;
+    col = cell / (Qubic::size * Qubic::size) * Qubic::size + cell % Qubic::size;
+}
+
+Variant::move_status QubicVariant::ParseMove(const char *str, int &cell) const
+{
+    int layer, rowi, coli;
+
+    if (sscanf(str, "%d %d %d", &layer, &rowi, &coli) != 3) { return invalid; }
+    if (layer < 0 || layer >= Qubic::size || rowi < 0 || rowi >= Qubic::size || 
+        coli < 0 || coli >= Qubic::size) {
+        return out_of_range;
+    }
+
+    cell = (layer * Qubic::size + rowi) * Qubic::size + coli;
+    if (!game.IsFree(cell)) { return busy; }
+
+    return valid;
+}
+
+void QubicVariant::FormatMove(int cell, char *buff, size_t size) const
+{
+    snprintf(buff, size, "%d %d %d", cell / (Qubic::size * Qubic::size), 
+             cell / Qubic::size % Qubic::size, cell % Qubic::size);
+}
+
+Variant::result QubicVariant::GetResult() const
+{
+    if (game.IsWon()) { return won; }
+    if (game.IsFull()) { return drawn; }
+
+    return going;
+}
+
+bool QubicVariant::Analyze(char *hints, long movetime)
+{
+    int scores[Qubic::cell_count];
+
+    memset(hints, 0, Qubic::cell_count);
+    if (bot.Analyze(game, movetime, scores) == 0) { return false; }
+
+    for (int i = 0; i < Qubic::cell_count; i++) {
+        if (game.IsFree(i)) { hints[i] = ScoreHint(scores[i], QubicBot::win_bound - 1); }
+    }
+
+    return true;
+}
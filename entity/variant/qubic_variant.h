@@ -0,0 +1,69 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUBIC_VARIANT_H_SENTRY
+#define QUBIC_VARIANT_H_SENTRY
+
+#include "variant.h"
+#include "../qubic/qubic.h"
+#include "../qubic/qubic_bot.h"
+
+/**
+ * @class QubicVariant
+ * @brief Tic-tac-toe in a 4x4x4 cube, the bot thinks for 1 s.
+ * 
+ * Moves are a layer, a row and a column. The layers are drawn side by
+ * side as blocks of 4 columns.
+ */
+class QubicVariant : public Variant {
+private:
+    enum { bot_movetime = 1000 };
+
+    Qubic game;
+    QubicBot bot;
+
+public:
+    QubicVariant() {}
+
+    const char *GetTitle() const { return "Qubic 4x4x4"; }
+    int GetRows() const { return Qubic::size; }
+    int GetCols() const { return Qubic::size * Qubic::size; }
+    int GetBlockCols() const { return Qubic::size; }
+    const char *GetBlockLabel() const { return "layer"; }
+    const char *GetMoveFormat() const { return "layer row column"; }
+    void ToGrid(int cell, int &row, int &col) const;
+    move_status ParseMove(const char *str, int &cell) const;
+    void FormatMove(int cell, char *buff, size_t size) const;
+    void Make(int cell) { game.Make(cell); }
+    void Unmake() { game.Unmake(); }
+    int GetMoveCount() const { return game.GetMoveCount(); }
+    int GetLastMove() const { return game.GetLastMove(); }
+    int GetMove(int i) const { return game.GetMove(i); }
+    result GetResult() const;
+    int BotMove() { return bot.Choose(game, bot_movetime); }
+    void Clear() { game.Clear(); }
+    bool Analyze(char *hints, long movetime);
+
+private:
+    QubicVariant(QubicVariant &v);
+    void operator=(QubicVariant &v);
+};
+
+#endif /* QUBIC_VARIANT_H_SENTRY */
@@ -0,0 +1,81 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ultimate_variant.h"
+
+void UltimateVariant::ToGrid(int cell, int &row, int &col) const
+{
+    int board = cell / 9, c = cell % 9;
+
+    row = board / 3 * 3 + c / 3;
+    col = board % 3 * 3 + c % 3;
+}
+
+Variant::move_status UltimateVariant::ParseMove(const char *str, int &cell) const
+{
+    int rowi, coli;
+
+    if (sscanf(str, "%d %d", &rowi, &coli) != 2) { return invalid; }
+    if (rowi < 0 || rowi >= 9 || coli < 0 || coli >= 9) { return out_of_range; }
+
+    cell = (rowi / 3 * 3 + coli / 3) * 9 + rowi % 3 * 3 + coli % 3;
+    if (game.GetMark(cell)) { return busy; }
+    if (!game.IsLegal(cell)) { return illegal; }
+
+    return valid;
+}
+
+void UltimateVariant::FormatMove(int cell, char *buff, size_t size) const
+{
+    int rowi, coli;
+
+    ToGrid(cell, rowi, coli);
+    snprintf(buff, size, "%d %d", rowi, coli);
+}
+
+Variant::result UltimateVariant::GetResult() const
+{
+    if (game.IsWon()) { return won; }
+    if (game.IsDrawn()) { return drawn; }
+
+    return going;
+}
+
+bool UltimateVariant::Analyze(char *hints, long movetime)
+{
+    int moves[Ultimate::cell_count];
+    float rates[Ultimate::cell_count];
+    int count;
+
+    memset(hints, 0, Ultimate::cell_count);
+    if (bot.Choose(game, movetime) == -1) { return false; }
+
+    /* Playouts are no proof, only clear leads are told apart */
+    count = bot.GetRootRates(moves, rates);
+    for (int i = 0; i < count; i++) {
+        if (rates[i] < 0) { hints[moves[i]] = '='; }
+        else { hints[moves[i]] = rates[i] > 0.6f ? '+' : rates[i] < 0.4f ? '-' : '='; }
+    }
+
+    return true;
+}
@@ -0,0 +1,68 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ULTIMATE_VARIANT_H_SENTRY
+#define ULTIMATE_VARIANT_H_SENTRY
+
+#include "variant.h"
+#include "../ultimate/ultimate.h"
+#include "../ultimate/ultimate_bot.h"
+
+/**
+ * @class UltimateVariant
+ * @brief Ultimate tic-tac-toe on a 9x9 grid of 3x3 boards.
+ * 
+ * Moves are a row and a column of the whole grid. The bot runs
+ * Monte Carlo tree search for 500 ms.
+ */
+class UltimateVariant : public Variant {
+private:
+    enum { bot_movetime = 500 };
+
+    Ultimate game;
+    UltimateBot bot;
+
+public:
+    UltimateVariant() {}
+
+    const char *GetTitle() const { return "Ultimate Tic Tac Toe"; }
+    int GetRows() const { return 9; }
+    int GetCols() const { return 9; }
+    int GetBlockRows() const { return 3; }
+    int GetBlockCols() const { return 3; }
+    void ToGrid(int cell, int &row, int &col) const;
+    move_status ParseMove(const char *str, int &cell) const;
+    void FormatMove(int cell, char *buff, size_t size) const;
+    void Make(int cell) { game.Make(cell); }
+    void Unmake() { game.Unmake(); }
+    int GetMoveCount() const { return game.GetMoveCount(); }
+    int GetLastMove() const { return game.GetLastMove(); }
+    int GetMove(int i) const { return game.GetMove(i); }
+    result GetResult() const;
+    int BotMove() { return bot.Choose(game, bot_movetime); }
+    void Clear() { game.Clear(); }
+    bool Analyze(char *hints, long movetime);
+
+private:
+    UltimateVariant(UltimateVariant &v);
+    void operator=(UltimateVariant &v);
+};
+
+#endif /* ULTIMATE_VARIANT_H_SENTRY */
@@ -0,0 +1,48 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "variant.h"
+#include "classic_variant.h"
+#include "gomoku_variant.h"
+#include "ultimate_variant.h"
+#include "qubic_variant.h"
+
+Variant::~Variant()
+{}
+
+Variant *Variant::Create(const char *name)
+{
+    if (strcmp(name, "classic") == 0) { return new ClassicVariant(); }
+    if (strcmp(name, "gomoku") == 0) { return new GomokuVariant(); }
+    if (strcmp(name, "ultimate") == 0) { return new UltimateVariant(); }
+    if (strcmp(name, "qubic") == 0) { return new QubicVariant(); }
+
+    return 0;
+}
+
+char Variant::ScoreHint(int score, int proven)
+{
+    if (score > proven) { return 'w'; }
+    if (score < -proven) { return 'l'; }
+
+    return score > 0 ? '+' : score < 0 ? '-' : '=';
+}
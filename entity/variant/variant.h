@@ -0,0 +1,156 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VARIANT_H_SENTRY
+#define VARIANT_H_SENTRY
+
+#include <stddef.h>
+
+/**
+ * @class Variant
+ * @brief Rules of a game played by Game: moves, results and the bot.
+ * 
+ * Sides are numbered in the order of moves, side 0 moves first.
+ * Cells are numbers of the variant, ConsoleUI shows them on a grid
+ * of Variant::GetRows by Variant::GetCols.
+ */
+class Variant {
+public:
+    /**
+     * @enum move_status
+     * @brief Result of Variant::ParseMove.
+     * 
+     * @var illegal The cell is free, but the rules forbid it now.
+     */
+    enum move_status { valid, invalid, busy, out_of_range, illegal };
+
+    /**
+     * @enum result
+     * @brief State of the game after the last move.
+     * 
+     * @var won The side that made the last move has won.
+     */
+    enum result { going, won, drawn };
+
+    virtual ~Variant();
+
+    /** @return Name shown in the panel, e.g. "Tic Tac Toe" */
+    virtual const char *GetTitle() const = 0;
+
+    virtual int GetRows() const = 0;
+    virtual int GetCols() const = 0;
+
+    /**
+     * @brief Size of the sub-grids ConsoleUI draws apart, 0 if none.
+     */
+    virtual int GetBlockRows() const { return 0; }
+    virtual int GetBlockCols() const { return 0; }
+
+    /**
+     * @brief Name of a block of columns, e.g. "layer", NULL if none.
+     * 
+     * Named blocks are numbered, and so are the columns inside them.
+     */
+    virtual const char *GetBlockLabel() const { return 0; }
+
+    /**
+     * @brief Numbers of a move in the order ParseMove reads them.
+     */
+    virtual const char *GetMoveFormat() const { return "row column"; }
+
+    /**
+     * @brief Position of the cell on the grid.
+     */
+    virtual void ToGrid(int cell, int &row, int &col) const = 0;
+
+    /**
+     * @brief Parses a move of the side to move, e.g. "1 1".
+     * 
+     * @param[out] cell Cell of the move if it's valid.
+     */
+    virtual move_status ParseMove(const char *str, int &cell) const = 0;
+
+    /**
+     * @brief Writes the move in the form Variant::ParseMove takes.
+     */
+    virtual void FormatMove(int cell, char *buff, size_t size) const = 0;
+
+    /**
+     * @brief Makes a valid move and takes it back in O(1).
+     * 
+     * The bots search on the same position through the same calls,
+     * and the history is kept by the variant.
+     */
+    virtual void Make(int cell) = 0;
+    virtual void Unmake() = 0;
+
+    virtual int GetMoveCount() const = 0;
+
+    /** @return Cell of the last move, -1 if none */
+    virtual int GetLastMove() const = 0;
+
+    /** @return Cell of the move at index [0; Variant::GetMoveCount) */
+    virtual int GetMove(int i) const = 0;
+
+    virtual result GetResult() const = 0;
+
+    /**
+     * @brief Move of the computer player for the side to move.
+     */
+    virtual int BotMove() = 0;
+
+    /**
+     * @brief Empties the field for a new game.
+     */
+    virtual void Clear() = 0;
+
+    /**
+     * @brief Values of all the moves of the side to move, for hints.
+     * 
+     * One search scores every move at once within the time. A value is
+     * a char: 'w', 'd' or 'l' if the result is proven, '+', '=' or '-'
+     * if it's an estimate. The other cells get '\0'.
+     * 
+     * @param[out] hints By cell.
+     * @param movetime Milliseconds at most.
+     * 
+     * @return false if the variant can't analyze.
+     */
+    virtual bool Analyze(char *hints, long movetime) 
+        { (void)hints; (void)movetime; return false; }
+
+    /**
+     * @brief Creates the variant by name ("classic", "gomoku", "ultimate",
+     *        "qubic").
+     * 
+     * @return NULL if the name is unknown.
+     */
+    static Variant *Create(const char *name);
+
+protected:
+    /**
+     * @brief Hint char of a negamax score of the side to move.
+     * 
+     * @param proven Scores above it or below its negation are exact.
+     */
+    static char ScoreHint(int score, int proven);
+};
+
+#endif /* VARIANT_H_SENTRY */
@@ -0,0 +1,433 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include "wall.h"
+#include "../stats/stats.h"
+#include "../terminal/terminal.h"
+
+/* The alternate screen without the cursor, see ConsoleUI::screen_on */
+static const char *const screen_enter = "\033[?1049h\033[?25l";
+static const char *const screen_leave = "\033[?25h\033[?1049l";
+
+/** Milliseconds a finished game stays on the screen */
+enum { pause_ms = 1000 };
+
+volatile sig_atomic_t Wall::resized = 0;
+
+Wall::Wall(int argc, char **argv)
+    : variant_name("classic")
+    , games(64)
+    , threads(sysconf(_SC_NPROCESSORS_ONLN))
+    , fps(30)
+    , delay(200)
+    , seconds(0)
+    , tiles(0)
+    , out(&OutputSink::Stdout())
+    , next_worker(0)
+    , stop(0)
+    , finished(0)
+    , draws(0)
+    , win_rows(0)
+    , win_cols(0)
+    , per_row(1)
+    , visible(0)
+{
+    const char *lines[max_tile_lines];
+    int n, width = 0;
+
+    wins[0] = wins[1] = 0;
+    header[0] = '\0';
+
+    for (int i = 0; i < argc; i++) {
+        if (i + 1 >= argc) { throw "Missing option value"; }
+
+        const char *val = argv[++i];
+
+        if (strcmp(argv[i - 1], "--variant") == 0) { variant_name = val; }
+        else if (strcmp(argv[i - 1], "--games") == 0) { games = atoi(val); }
+        else if (strcmp(argv[i - 1], "--threads") == 0) { threads = atoi(val); }
+        else if (strcmp(argv[i - 1], "--fps") == 0) { fps = atoi(val); }
+        else if (strcmp(argv[i - 1], "--delay") == 0) { delay = atoi(val); }
+        else if (strcmp(argv[i - 1], "--seconds") == 0) { seconds = atoi(val); }
+        else { throw "Unknown option"; }
+    }
+
+    if (games <= 0 || fps <= 0 || delay < 0 || seconds < 0) { 
+        throw "Bad option value"; 
+    }
+    if (threads <= 0) { threads = 1; }
+    if (threads > games) { threads = games; }
+
+    Variant *probe = Variant::Create(variant_name);
+    if (!probe) { throw "Unknown variant"; }
+    delete probe;
+
+    plr[0] = new Player("X", 'X');
+    plr[1] = new Player("O", 'O');
+
+    tiles = new tile[games];
+    for (int i = 0; i < games; i++) {
+        tile &t = tiles[i];
+
+        t.variant = Variant::Create(variant_name);
+        t.ui = new ConsoleUI(t.variant->GetRows(), t.variant->GetCols(), 
+                             t.variant->GetTitle(), 
+                             t.variant->GetBlockRows(), 
+                             t.variant->GetBlockCols());
+        t.ui->SetBlockLabel(t.variant->GetBlockLabel());
+        pthread_mutex_init(&t.lock, 0);
+        t.version = 1;
+        t.shown = 0;
+        t.screen = 0;
+        t.game = 1;
+        t.over = false;
+        t.due = 0;
+        snprintf(t.status, sizeof(t.status), "#1 %c to move", 
+                 plr[0]->GetMark());
+    }
+
+    /* An empty field has the size of any other */
+    n = tiles[0].ui->RenderField(lines, max_tile_lines);
+    for (int i = 0; i < n; i++) {
+        int len = strlen(lines[i]);
+        if (len > width) { width = len; }
+    }
+    if (width < status_size / 3) { width = status_size / 3; }
+
+    tile_rows = n + 2;
+    tile_cols = width + gap_cols;
+
+    for (int i = 0; i < games; i++) {
+        tiles[i].screen = new char[(tile_rows - 1) * width];
+    }
+}
+
+Wall::~Wall()
+{
+    for (int i = 0; i < games; i++) {
+        pthread_mutex_destroy(&tiles[i].lock);
+        delete[] tiles[i].screen;
+        delete tiles[i].ui;
+        delete tiles[i].variant;
+    }
+    delete[] tiles;
+    delete plr[0];
+    delete plr[1];
+}
+
+void Wall::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s wall [options]\n"
+            "  --games N            concurrent bot games (64)\n"
+            "  --variant NAME       classic, gomoku, ultimate, qubic "
+            "(classic)\n"
+            "  --threads N          worker threads (all cores)\n"
+            "  --fps N              most frames a second (30)\n"
+            "  --delay MS           pause between the moves of a game "
+            "(200)\n"
+            "  --seconds N          stop after N seconds (0: on 'q')\n", 
+            name);
+}
+
+int Wall::Run()
+{
+    pthread_t *tid;
+    int started = 0;
+    struct sigaction sa, saved_winch;
+    MemorySink frame;
+    uint64_t start, period = 1000000000ULL / fps;
+    uint64_t total_ns = 0, max_ns = 0;
+    unsigned long long bytes = 0;
+    long frames = 0;
+    bool input = true;
+
+    if (!out->GetWindow(win_rows, win_cols)) {
+        fprintf(stderr, "wall: the output is not a terminal\n");
+        return 1;
+    }
+
+    Terminal terminal;
+    terminal.SetSignalText(screen_leave, screen_enter);
+    terminal.Apply(Terminal::raw, 0, 1);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = OnResize;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &sa, &saved_winch);
+
+    out->Puts(screen_enter);
+    resized = 1;
+
+    tid = new pthread_t[threads];
+    for (; started < threads; started++) {
+        if (pthread_create(&tid[started], 0, Worker, this) != 0) { break; }
+    }
+    if (started == 0) {
+        delete[] tid;
+        out->Puts(screen_leave);
+        sigaction(SIGWINCH, &saved_winch, 0);
+        fprintf(stderr, "wall: can't start the workers\n");
+        return 1;
+    }
+
+    start = Stats::Now();
+
+    for (;;) {
+        uint64_t begin = Stats::Now();
+        pollfd pfd;
+        long wait_ms;
+        char key;
+
+        frame.Clear();
+        Compose(frame);
+        if (frame.GetLength()) {
+            uint64_t ns;
+
+            out->Write(frame.GetData(), frame.GetLength());
+            ns = Stats::Now() - begin;
+
+            frames++;
+            total_ns += ns;
+            if (ns > max_ns) { max_ns = ns; }
+            bytes += frame.GetLength();
+        }
+
+        if (seconds && Stats::Now() - start >= seconds * 1000000000ULL) { 
+            break; 
+        }
+
+        /* Until the next frame, a key may end it */
+        wait_ms = static_cast<long>(begin + period - Stats::Now()) / 1000000;
+        if (wait_ms < 0) { wait_ms = 0; }
+        if (!input) { 
+            usleep(wait_ms * 1000);
+            continue;
+        }
+
+        pfd.fd = STDIN_FILENO;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, wait_ms) <= 0) { continue; }
+        if (read(STDIN_FILENO, &key, 1) != 1) { input = false; }
+        else if (key == 'q') { break; }
+    }
+
+    __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < started; i++) { pthread_join(tid[i], 0); }
+    delete[] tid;
+
+    out->Puts(screen_leave);
+    sigaction(SIGWINCH, &saved_winch, 0);
+
+    printf("%d games on %d threads: %ld finished, X %ld, O %ld, draw %ld\n",
+           games, started, finished, wins[0], wins[1], draws);
+    printf("%ld frames of %d tiles: %.3f ms average, %.3f ms max, "
+           "%.0f bytes\n", frames, visible, 
+           frames ? total_ns / 1e6 / frames : 0.0, max_ns / 1e6,
+           frames ? static_cast<double>(bytes) / frames : 0.0);
+
+    return 0;
+}
+
+void *Wall::Worker(void *arg)
+{
+    Wall *w = static_cast<Wall *>(arg);
+    int id = __atomic_fetch_add(&w->next_worker, 1, __ATOMIC_RELAXED);
+
+    /* The games id, id + threads, ... are this worker's */
+    while (!__atomic_load_n(&w->stop, __ATOMIC_RELAXED)) {
+        uint64_t now = Stats::Now();
+        uint64_t wake = now + 50000000ULL;
+
+        for (int i = id; i < w->games; i += w->threads) {
+            tile &t = w->tiles[i];
+
+            if (t.due <= now) {
+                w->Step(t, now);
+                now = Stats::Now();
+            }
+            if (t.due < wake) { wake = t.due; }
+        }
+
+        if (wake > now) { usleep((wake - now) / 1000); }
+    }
+
+    return 0;
+}
+
+void Wall::Step(tile &t, uint64_t now)
+{
+    int side, cell, rowi, coli;
+    Variant::result res;
+
+    if (t.over) {
+        t.variant->Clear();
+
+        pthread_mutex_lock(&t.lock);
+        t.ui->ClearField();
+        t.game++;
+        snprintf(t.status, sizeof(t.status), "#%d %c to move", 
+                 t.game, plr[0]->GetMark());
+        t.version++;
+        pthread_mutex_unlock(&t.lock);
+
+        t.over = false;
+        t.due = now + delay * 1000000ULL;
+        return;
+    }
+
+    /* The bot thinks outside the lock, the compositor doesn't wait */
+    side = t.variant->GetMoveCount() % 2;
+    cell = t.variant->BotMove();
+    t.variant->Make(cell);
+    t.variant->ToGrid(cell, rowi, coli);
+    res = t.variant->GetResult();
+
+    pthread_mutex_lock(&t.lock);
+    t.ui->SetMark(rowi, coli, *plr[side]);
+    if (res == Variant::won) {
+        snprintf(t.status, sizeof(t.status), "#%d %c won", 
+                 t.game, plr[side]->GetMark());
+    }
+    else if (res == Variant::drawn) {
+        snprintf(t.status, sizeof(t.status), "#%d draw", t.game);
+    }
+    else {
+        snprintf(t.status, sizeof(t.status), "#%d %c to move", 
+                 t.game, plr[!side]->GetMark());
+    }
+    t.version++;
+    pthread_mutex_unlock(&t.lock);
+
+    if (res == Variant::going) {
+        t.due = Stats::Now() + delay * 1000000ULL;
+        return;
+    }
+
+    t.over = true;
+    t.due = Stats::Now() + pause_ms * 1000000ULL;
+
+    __atomic_fetch_add(&finished, 1, __ATOMIC_RELAXED);
+    if (res == Variant::won) { __atomic_fetch_add(&wins[side], 1, __ATOMIC_RELAXED); }
+    else { __atomic_fetch_add(&draws, 1, __ATOMIC_RELAXED); }
+}
+
+void Wall::Layout(MemorySink &frame)
+{
+    int rows_fit;
+
+    resized = 0;
+    if (!out->GetWindow(win_rows, win_cols)) {
+        win_rows = 24;
+        win_cols = 80;
+    }
+
+    /* The header takes the first row */
+    per_row = win_cols / tile_cols > 0 ? win_cols / tile_cols : 1;
+    rows_fit = (win_rows - 1) / tile_rows;
+    visible = per_row * rows_fit < games ? per_row * rows_fit : games;
+
+    /* The screen is cleared: no line of it is known */
+    for (int i = 0; i < games; i++) {
+        pthread_mutex_lock(&tiles[i].lock);
+        tiles[i].shown = tiles[i].version - 1;
+        memset(tiles[i].screen, 0, (tile_rows - 1) * (tile_cols - gap_cols));
+        pthread_mutex_unlock(&tiles[i].lock);
+    }
+    header[0] = '\0';
+
+    frame.Puts("\033[2J");
+}
+
+void Wall::Compose(MemorySink &frame)
+{
+    const char *lines[max_tile_lines];
+    char line[sizeof(header)];
+
+    if (resized) { Layout(frame); }
+
+    for (int k = 0; k < visible; k++) {
+        tile &t = tiles[k];
+        int top = 2 + k / per_row * tile_rows;
+        int left = 1 + k % per_row * tile_cols;
+
+        pthread_mutex_lock(&t.lock);
+        if (t.shown != t.version) {
+            int n = t.ui->RenderField(lines, max_tile_lines);
+            int width = tile_cols - gap_cols;
+
+            PutLine(frame, top, left, t.status, t.screen);
+            for (int i = 0; i < tile_rows - 2; i++) {
+                PutLine(frame, top + 1 + i, left, i < n ? lines[i] : "", 
+                        t.screen + (i + 1) * width);
+            }
+            t.shown = t.version;
+        }
+        pthread_mutex_unlock(&t.lock);
+    }
+
+    snprintf(line, sizeof(line), 
+             "ttt wall: %d games, %d shown, finished %ld: X %ld, O %ld, "
+             "draw %ld   'q' quits", 
+             games, visible, __atomic_load_n(&finished, __ATOMIC_RELAXED),
+             __atomic_load_n(&wins[0], __ATOMIC_RELAXED),
+             __atomic_load_n(&wins[1], __ATOMIC_RELAXED),
+             __atomic_load_n(&draws, __ATOMIC_RELAXED));
+    if (strcmp(line, header) != 0) {
+        strcpy(header, line);
+        if (static_cast<int>(strlen(line)) > win_cols) { line[win_cols] = '\0'; }
+        frame.Print("\033[1;1H%s\033[K", line);
+    }
+}
+
+void Wall::PutLine(MemorySink &frame, int row, int col, const char *text, 
+                   char *shown)
+{
+    int width = tile_cols - gap_cols;
+    int len = strlen(text);
+
+    if (len > width) { len = width; }
+
+    /* A move changes a line or two of a tile */
+    if (memcmp(shown, text, len) == 0) {
+        int i = len;
+
+        while (i < width && shown[i] == ' ') { i++; }
+        if (i == width) { return; }
+    }
+
+    memcpy(shown, text, len);
+    memset(shown + len, ' ', width - len);
+
+    frame.Print("\033[%d;%dH", row, col);
+    frame.Write(shown, width);
+}
+
+void Wall::OnResize(int)
+{
+    resized = 1;
+}
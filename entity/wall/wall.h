@@ -0,0 +1,142 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef WALL_H_SENTRY
+#define WALL_H_SENTRY
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+
+#include "../variant/variant.h"
+#include "../console_ui/console_ui.h"
+#include "../output_sink/output_sink.h"
+#include "../player/player.h"
+
+/**
+ * @class Wall
+ * @brief Concurrent bot-vs-bot games in a grid of tiles ("ttt wall").
+ * 
+ * The games are split among the worker threads, each plays the moves
+ * of its games when they are due, with its own Variant and bot. Every
+ * game has a ConsoleUI that only holds its field: a single compositor
+ * redraws at most --fps times a second, and only the tiles whose games
+ * have changed since the last frame, from ConsoleUI::RenderField. The
+ * frame is composed in memory and written in one call.
+ */
+class Wall {
+private:
+    enum { max_tile_lines = 32, status_size = 48, gap_cols = 2 };
+
+    /**
+     * @struct tile
+     * @brief A game and its place on the screen.
+     */
+    struct tile {
+        Variant *variant;           /**< Used by its worker only */
+        ConsoleUI *ui;
+        pthread_mutex_t lock;       /**< Guards ui, status and version */
+        unsigned version;           /**< Changes of the tile */
+        unsigned shown;             /**< Version on the screen */
+        char *screen;               /**< Lines on the screen, padded */
+        char status[status_size];
+        int game;                   /**< Number of the game in the tile */
+        bool over;
+        uint64_t due;               /**< Stats::Now of the next step */
+    };
+
+    const char *variant_name;
+    int games;
+    int threads;
+    int fps;
+    int delay;                  /**< Milliseconds between moves */
+    int seconds;                /**< Run time, 0 until 'q' */
+
+    tile *tiles;
+    Player *plr[2];
+    OutputSink *out;
+
+    int next_worker;            /**< Index of the next started worker */
+    int stop;                   /**< Set to end the workers */
+
+    /* Results of the finished games, updated atomically */
+    long finished, wins[2], draws;
+
+    /* The screen, used by the compositor only */
+    int win_rows, win_cols;
+    int tile_rows, tile_cols;   /**< With the status line and the gap */
+    int per_row;                /**< Tiles in a row of the screen */
+    int visible;                /**< Tiles that fit, the first ones */
+    char header[128];           /**< Top line on the screen */
+
+    /** Set by SIGWINCH, the tiles are laid out again */
+    static volatile sig_atomic_t resized;
+
+public:
+    /**
+     * @param argc, argv Options after "wall", see Wall::Usage.
+     * 
+     * @throws const char * on invalid arguments or an unknown variant.
+     */
+    Wall(int argc, char **argv);
+    ~Wall();
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Wall(Wall &w);
+    void operator=(Wall &w);
+
+    static void *Worker(void *arg);
+
+    /**
+     * @brief Plays the next move of the game, or starts the next game
+     *        after a finished one.
+     */
+    void Step(tile &t, uint64_t now);
+
+    /**
+     * @brief Fits the tiles to the window, the next frame draws all.
+     */
+    void Layout(MemorySink &frame);
+
+    /**
+     * @brief Appends the changed tiles and the header to the frame.
+     */
+    void Compose(MemorySink &frame);
+
+    /**
+     * @brief Appends a line of the tile, padded to the tile width, if
+     *        it differs from the one on the screen.
+     * 
+     * @param shown The line on the screen, updated.
+     */
+    void PutLine(MemorySink &frame, int row, int col, const char *text, 
+                 char *shown);
+
+    static void OnResize(int sig);
+};
+
+#endif /* WALL_H_SENTRY */
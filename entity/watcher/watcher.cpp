@@ -0,0 +1,232 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include "watcher.h"
+#include "../terminal/terminal.h"
+
+Watcher::Watcher(int argc, char **argv)
+    : reader(0)
+    , delay(0)
+    , resyncs(0)
+    , ui(0)
+    , panel(ConsoleUI::info)
+    , panel_plr(Broadcast::no_player)
+{
+    const char *name = 0;
+
+    plr[0] = plr[1] = 0;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--delay") == 0) {
+            if (++i >= argc || (delay = atoi(argv[i])) <= 0) { 
+                throw "Bad option value"; 
+            }
+        }
+        else if (argv[i][0] == '-') { throw "Unknown option"; }
+        else if (name) { throw "Only one game at a time"; }
+        else { name = argv[i]; }
+    }
+
+    if (!name) { throw "Missing game name"; }
+
+    reader = new BroadcastReader(name);
+
+    const Broadcast::layout &info = reader->GetLayout();
+
+    ui = new ConsoleUI(info.rows, info.cols, info.title, info.block_rows, 
+                       info.block_cols);
+    if (info.block_label[0]) { ui->SetBlockLabel(info.block_label); }
+}
+
+Watcher::~Watcher()
+{
+    delete ui;
+    delete plr[0];
+    delete plr[1];
+    delete reader;
+}
+
+void Watcher::Usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s watch NAME [options]\n"
+            "  NAME                 game started with --publish NAME\n"
+            "  --delay MS           wait after each event, a slow "
+            "spectator\n", name);
+}
+
+int Watcher::Run()
+{
+    const Broadcast::layout &info = reader->GetLayout();
+    Broadcast::snapshot snap;
+    Broadcast::event events[batch];
+    Terminal terminal;
+    bool sync = true, input = true;
+
+    /* The players are named before the first event */
+    for (int i = 0; i < 2; i++) {
+        plr[i] = new Player(info.names[i][0] ? info.names[i] : "Player", 
+                            info.marks[i] ? info.marks[i] : 'X' + i);
+    }
+
+    if (ui->EnterScreen()) {
+        terminal.SetSignalText(ConsoleUI::screen_off, ConsoleUI::screen_on);
+    }
+    terminal.Apply(Terminal::raw, 0, 1);
+
+    for (;;) {
+        bool closed = reader->IsClosed();
+        int n = 0;
+
+        if (sync) {
+            reader->ReadSnapshot(snap);
+            Restore(snap);
+            sync = false;
+        }
+        else {
+            n = reader->Poll(events, delay ? 1 : batch);
+            if (n < 0) {
+                resyncs++;
+                sync = true;
+                continue;
+            }
+
+            for (int i = 0; i < n; i++) { Apply(events[i]); }
+            if (n > 0) { Render(); }
+        }
+
+        if (closed && n == 0) { break; }
+        if (n == batch) { continue; }
+
+        if (delay) { usleep(delay * 1000); }
+        if (!WaitKey(input)) { break; }
+    }
+
+    ui->LeaveScreen(true);
+    if (resyncs) { fprintf(stderr, "resynced %ld times\n", resyncs); }
+
+    return 0;
+}
+
+void Watcher::Restore(const Broadcast::snapshot &s)
+{
+    const Broadcast::layout &info = reader->GetLayout();
+
+    ui->ClearField();
+    ui->DeleteAllMove();
+
+    for (int rowi = 0; rowi < info.rows; rowi++) {
+        for (int coli = 0; coli < info.cols; coli++) {
+            int m = s.marks[rowi * info.cols + coli];
+
+            if (m) { ui->SetMark(rowi, coli, *plr[m - 1]); }
+        }
+    }
+
+    /* The last mark is shown in brackets */
+    if (s.last_row != -1) {
+        ui->SetMark(s.last_row, s.last_col, 
+                    *plr[s.marks[s.last_row * info.cols + s.last_col] - 1]);
+    }
+
+    for (int i = 0; i < s.line_count; i++) { AddLine(s.lines[i]); }
+
+    panel = s.panel;
+    panel_plr = s.panel_plr;
+    Render();
+}
+
+void Watcher::Apply(const Broadcast::event &e)
+{
+    switch (e.type) {
+        case Broadcast::reset:
+            ui->ClearField();
+            ui->DeleteAllMove();
+            break;
+        case Broadcast::mark:
+            ui->SetMark(e.row, e.col, *plr[e.plr & 1]);
+            break;
+        case Broadcast::unmark:
+            ui->ClearMark(e.row, e.col);
+            break;
+        case Broadcast::line:
+            AddLine(e);
+            break;
+        case Broadcast::clear_lines:
+            ui->DeleteAllMove();
+            break;
+        case Broadcast::panel:
+            panel = e.row;
+            panel_plr = e.plr;
+            break;
+    }
+}
+
+void Watcher::AddLine(const Broadcast::event &e)
+{
+    enum color { red = 31, blue = 34 };
+    char line_buff[80];
+
+    if (e.plr == Broadcast::no_player) {
+        snprintf(line_buff, sizeof(line_buff), "%d> %s", 
+                 e.move_count, e.text);
+    }
+    else {
+        snprintf(line_buff, sizeof(line_buff), "\033[%dm%d>\033[0m %s",
+                 e.plr ? red : blue, e.move_count, e.text);
+    }
+    ui->AddMove(line_buff, sizeof(line_buff));
+}
+
+void Watcher::Render()
+{
+    ui->Clear();
+    ui->Print(static_cast<ConsoleUI::panel_version>(panel), 
+              panel_plr < 2 ? plr[panel_plr] : 0);
+}
+
+bool Watcher::WaitKey(bool &input)
+{
+    pollfd pfd;
+    char key;
+
+    if (!input) { 
+        usleep(poll_ms * 1000);
+        return true;
+    }
+
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, poll_ms) <= 0) { return true; }
+
+    /* Without a terminal stdin may end, only the game is followed then */
+    if (read(STDIN_FILENO, &key, 1) != 1) { 
+        input = false; 
+        return true;
+    }
+
+    return key != 'q';
+}
@@ -0,0 +1,91 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef WATCHER_H_SENTRY
+#define WATCHER_H_SENTRY
+
+#include "../broadcast/broadcast.h"
+#include "../console_ui/console_ui.h"
+
+/**
+ * @class Watcher
+ * @brief Spectator of a published game ("ttt watch NAME").
+ * 
+ * The game is followed through a BroadcastReader and drawn by the same
+ * ConsoleUI as the players see, on the alternate screen if stdout is a
+ * terminal. The watcher only reads the shared memory: if it falls a
+ * ring behind, it redraws from the snapshot and goes on. 'q' quits.
+ */
+class Watcher {
+private:
+    enum { poll_ms = 20, batch = 64 };
+
+    BroadcastReader *reader;
+    int delay;                  /**< Milliseconds per event, 0 if none */
+    long resyncs;               /**< Snapshots read after an overrun */
+
+    ConsoleUI *ui;
+    Player *plr[2];
+    int panel, panel_plr;       /**< See Broadcast::snapshot */
+
+public:
+    /**
+     * @param argc, argv Name and options after "watch", see Usage.
+     * 
+     * @throws const char * on invalid arguments or if no such game is
+     *         published.
+     */
+    Watcher(int argc, char **argv);
+    ~Watcher();
+
+    /**
+     * @return Exit status of the program.
+     */
+    int Run();
+
+    static void Usage(const char *name);
+
+private:
+    Watcher(Watcher &w);
+    void operator=(Watcher &w);
+
+    /**
+     * @brief Redraws the field, history and panel of the snapshot.
+     */
+    void Restore(const Broadcast::snapshot &s);
+
+    void Apply(const Broadcast::event &e);
+
+    /**
+     * @brief Adds a line of the history as Game::RecordLine does.
+     */
+    void AddLine(const Broadcast::event &e);
+
+    void Render();
+
+    /**
+     * @brief Waits for a key up to poll_ms.
+     * 
+     * @return false if 'q' was pressed.
+     */
+    bool WaitKey(bool &input);
+};
+
+#endif /* WATCHER_H_SENTRY */
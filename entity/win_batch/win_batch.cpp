@@ -0,0 +1,209 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define WIN_BATCH_X86
+#endif
+
+#include "win_batch.h"
+
+/**
+ * @brief One board at a time, the reference for the vector versions.
+ */
+template <class T>
+static void CheckScalar(const T *masks, int count, 
+                        const T *lines, int line_count, uint8_t *win)
+{
+    for (int i = 0; i < count; i++) {
+        uint8_t res = 0;
+        for (int l = 0; l < line_count; l++) {
+            res |= (masks[i] & lines[l]) == lines[l];
+        }
+        win[i] = res;
+    }
+}
+
+#ifdef WIN_BATCH_X86
+
+__attribute__((target("sse2")))
+static void CheckSse2(const uint16_t *masks, int count,
+                      const uint16_t *lines, int line_count, uint8_t *win)
+{
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(masks + i));
+        __m128i acc = _mm_setzero_si128();
+
+        for (int l = 0; l < line_count; l++) {
+            __m128i line = _mm_set1_epi16(lines[l]);
+            acc = _mm_or_si128(acc, _mm_cmpeq_epi16(_mm_and_si128(m, line), line));
+        }
+
+        /* 0xffff/0 words to 1/0 bytes */
+        acc = _mm_packs_epi16(acc, acc);
+        acc = _mm_and_si128(acc, _mm_set1_epi8(1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(win + i), acc);
+    }
+
+    CheckScalar(masks + i, count - i, lines, line_count, win + i);
+}
+
+__attribute__((target("sse2")))
+static void CheckSse2(const uint64_t *masks, int count,
+                      const uint64_t *lines, int line_count, uint8_t *win)
+{
+    int i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(masks + i));
+        __m128i acc = _mm_setzero_si128();
+
+        for (int l = 0; l < line_count; l++) {
+            __m128i line = _mm_set1_epi64x(lines[l]);
+            __m128i eq = _mm_cmpeq_epi32(_mm_and_si128(m, line), line);
+
+            /* Both halves of a 64-bit lane must be equal */
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            acc = _mm_or_si128(acc, eq);
+        }
+
+        int bits = _mm_movemask_pd(_mm_castsi128_pd(acc));
+        win[i] = bits & 1;
+        win[i + 1] = bits >> 1 & 1;
+    }
+
+    CheckScalar(masks + i, count - i, lines, line_count, win + i);
+}
+
+__attribute__((target("avx2")))
+static void CheckAvx2(const uint16_t *masks, int count,
+                      const uint16_t *lines, int line_count, uint8_t *win)
+{
+    int i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(masks + i));
+        __m256i acc = _mm256_setzero_si256();
+
+        for (int l = 0; l < line_count; l++) {
+            __m256i line = _mm256_set1_epi16(lines[l]);
+            acc = _mm256_or_si256(acc, 
+                    _mm256_cmpeq_epi16(_mm256_and_si256(m, line), line));
+        }
+
+        /* 0xffff/0 words to 1/0 bytes */
+        __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(acc),
+                                         _mm256_extracti128_si256(acc, 1));
+        packed = _mm_and_si128(packed, _mm_set1_epi8(1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(win + i), packed);
+    }
+
+    CheckSse2(masks + i, count - i, lines, line_count, win + i);
+}
+
+__attribute__((target("avx2")))
+static void CheckAvx2(const uint64_t *masks, int count,
+                      const uint64_t *lines, int line_count, uint8_t *win)
+{
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(masks + i));
+        __m256i acc = _mm256_setzero_si256();
+
+        for (int l = 0; l < line_count; l++) {
+            __m256i line = _mm256_set1_epi64x(lines[l]);
+            acc = _mm256_or_si256(acc, 
+                    _mm256_cmpeq_epi64(_mm256_and_si256(m, line), line));
+        }
+
+        int bits = _mm256_movemask_pd(_mm256_castsi256_pd(acc));
+        for (int j = 0; j < 4; j++) { win[i + j] = bits >> j & 1; }
+    }
+
+    CheckSse2(masks + i, count - i, lines, line_count, win + i);
+}
+
+#endif /* WIN_BATCH_X86 */
+
+WinBatch::WinBatch(const Board &board)
+    : line_count(board.GetLineCount())
+    , narrow(board.GetCellCount() <= 16)
+    , impl(DetectIsa())
+{
+    for (int i = 0; i < line_count; i++) {
+        line[i] = board.GetLine(i);
+        line16[i] = static_cast<uint16_t>(line[i]);
+    }
+}
+
+void WinBatch::Check(const uint16_t *masks, int count, uint8_t *win) const
+{
+    switch (impl) {
+#ifdef WIN_BATCH_X86
+        case avx2: CheckAvx2(masks, count, line16, line_count, win); return;
+        case sse2: CheckSse2(masks, count, line16, line_count, win); return;
+#endif
+        default: CheckScalar(masks, count, line16, line_count, win); return;
+    }
+}
+
+void WinBatch::Check(const uint64_t *masks, int count, uint8_t *win) const
+{
+    switch (impl) {
+#ifdef WIN_BATCH_X86
+        case avx2: CheckAvx2(masks, count, line, line_count, win); return;
+        case sse2: CheckSse2(masks, count, line, line_count, win); return;
+#endif
+        default: CheckScalar(masks, count, line, line_count, win); return;
+    }
+}
+
+bool WinBatch::SetIsa(isa i)
+{
+    if (i > DetectIsa()) { return false; }
+
+    impl = i;
+    return true;
+}
+
+const char *WinBatch::IsaName(isa i)
+{
+    switch (i) {
+        case scalar: return "scalar";
+        case sse2: return "sse2";
+        case avx2: return "avx2";
+    }
+
+    return "unknown";
+}
+
+WinBatch::isa WinBatch::DetectIsa()
+{
+#ifdef WIN_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return avx2; }
+    if (__builtin_cpu_supports("sse2")) { return sse2; }
+#endif
+
+    return scalar;
+}
@@ -0,0 +1,95 @@
+/* 
+ * This file is part of ttt.
+ * ttt - Tic-tac-toe in a terminal.
+ *
+ * Copyright (C) 2026 Egorov Konstantin
+ *
+ * ttt is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * ttt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ttt. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef WIN_BATCH_H_SENTRY
+#define WIN_BATCH_H_SENTRY
+
+#include <stdint.h>
+
+#include "../board/board.h"
+
+/**
+ * @class WinBatch
+ * @brief Win detection for many independent boards at once.
+ * 
+ * Masks of one side are given in struct-of-arrays layout: element i
+ * of the array is the mask of board i. Every line of the rules is
+ * tested against 16 boards (16-bit masks, AVX2), 8 boards (16-bit, 
+ * SSE2) or 4 and 2 boards (64-bit masks) per instruction. The
+ * instruction set is chosen at run time, with a scalar fallback.
+ */
+class WinBatch {
+public:
+    /**
+     * @enum isa
+     * @brief Implementation used by WinBatch::Check.
+     */
+    enum isa { scalar, sse2, avx2 };
+
+private:
+    int line_count;
+    uint64_t line[Board::max_lines];        /**< From the board rules */
+    uint16_t line16[Board::max_lines];      /**< Same, for up to 16 cells */
+    bool narrow;                            /**< All lines fit 16 bits */
+    isa impl;
+
+public:
+    /**
+     * @brief Takes the lines of the board (size and k).
+     */
+    WinBatch(const Board &board);
+
+    /**
+     * @brief Tests boards of up to 16 cells (3x3, 4x4).
+     * 
+     * @param masks Marks of one side of each board.
+     * @param count Number of boards.
+     * @param[out] win 1 if the board has a complete line, 0 otherwise.
+     * 
+     * @note Only valid if WinBatch::IsNarrow.
+     */
+    void Check(const uint16_t *masks, int count, uint8_t *win) const;
+
+    /**
+     * @brief Tests boards of any size.
+     * 
+     * @see WinBatch::Check(const uint16_t *, int, uint8_t *)
+     */
+    void Check(const uint64_t *masks, int count, uint8_t *win) const;
+
+    /**
+     * @brief Selects the implementation, e.g. scalar for comparison.
+     * 
+     * @return false if the CPU doesn't support it.
+     */
+    bool SetIsa(isa i);
+    isa GetIsa() const { return impl; }
+    bool IsNarrow() const { return narrow; }
+
+    static const char *IsaName(isa i);
+
+private:
+    /**
+     * @brief The best implementation supported by the CPU.
+     */
+    static isa DetectIsa();
+};
+
+#endif /* WIN_BATCH_H_SENTRY */
@@ -18,14 +18,303 @@
  * along with ttt. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "entity/game/game.h"
+#include "entity/engine/engine.h"
+#include "entity/tournament/tournament.h"
+#include "entity/stats/stats.h"
+#include "entity/trace/trace.h"
+#include "entity/rng/rng.h"
+#include "entity/bench/bench.h"
+#include "entity/perft/perft.h"
+#include "entity/enumerator/enumerator.h"
+#include "entity/selfplay/selfplay_runner.h"
+#include "entity/learner/learner.h"
+#include "entity/dfpn/solve_runner.h"
+#include "entity/watcher/watcher.h"
+#include "entity/wall/wall.h"
 
-int main(int argc, char **argv)
+static void Usage(const char *name)
+{
+    fprintf(stderr, 
+            "Usage: %s [OPTIONS] [COMMAND]\n"
+            "Commands:\n"
+            "  (none)               play in the terminal\n"
+            "  batch [FILE]         play the games scripted in FILE "
+            "(stdin by default)\n"
+            "  engine               text protocol for the bot search\n"
+            "  tournament           matches between bot configurations\n"
+            "  bench NAME           micro-benchmarks\n"
+            "  selfplay             headless bot-vs-bot games\n"
+            "  learn                train a value table by self-play\n"
+            "  solve                prove the result of the empty board\n"
+            "  perft                count the game tree by ply\n"
+            "  enumerate            count the reachable positions by ply\n"
+            "  watch NAME           follow a game started with --publish\n"
+            "  wall                 a grid of concurrent bot games\n"
+            "Options:\n"
+            "  --stats              print latency of the game phases on exit\n"
+            "  --stats-json FILE    write the latency histograms as JSON\n"
+            "  --trace FILE         write spans in the Chrome trace format\n"
+            "  --seed N             seed of all random choices\n"
+            "  --variant NAME       classic, gomoku, ultimate, qubic\n"
+            "  --clock BASE[+INC]   time control in seconds, e.g. 180+2\n"
+            "  --publish NAME       let spectators watch the game\n",
+            name);
+}
+
+/** Rules of the played games, see Variant::Create */
+static const char *variant_name = "classic";
+
+/** Time control of the interactive game, NULL if none */
+static const char *clock_spec = 0;
+
+/** Name of the game for spectators, NULL if not published */
+static const char *publish_name = 0;
+
+/**
+ * @brief Plays interactive or scripted games.
+ * 
+ * @param script_fd Source of the script, -1 for the interactive game.
+ */
+static int Play(int script_fd)
 {
-    Game *game = new Game();
+    Game *game;
+
+    try {
+        game = script_fd == -1 ? new Game(variant_name)
+                               : new Game(script_fd, variant_name);
+    }
+    catch (const char *err) {
+        fprintf(stderr, "%s\n", err);
+        return 1;
+    }
+
+    try {
+        if (clock_spec && script_fd == -1) { game->SetClock(clock_spec); }
+        if (publish_name && script_fd == -1) { game->Publish(publish_name); }
+    }
+    catch (const char *err) {
+        fprintf(stderr, "%s\n", err);
+        delete game;
+        return 1;
+    }
 
     while (game->Start() == Game::restart) { game->Reset(); }
 
     delete game;
     return 0;
 }
+
+/**
+ * @brief Runs the command.
+ * 
+ * @param argc, argv The command and its arguments.
+ * @return Exit status of the program.
+ */
+static int Command(const char *name, int argc, char **argv)
+{
+    if (argc == 0) { return Play(-1); }
+
+    if (strcmp(argv[0], "engine") == 0) {
+        try {
+            Engine engine(STDIN_FILENO);
+            return engine.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "tournament") == 0) {
+        try {
+            Tournament tournament(argc - 1, argv + 1);
+            return tournament.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Tournament::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "bench") == 0) {
+        try {
+            Bench bench(argc - 1, argv + 1);
+            return bench.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Bench::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "selfplay") == 0) {
+        try {
+            SelfPlayRunner runner(argc - 1, argv + 1);
+            return runner.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            SelfPlayRunner::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "learn") == 0) {
+        try {
+            Learner learner(argc - 1, argv + 1);
+            return learner.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Learner::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "solve") == 0) {
+        try {
+            SolveRunner runner(argc - 1, argv + 1);
+            return runner.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            SolveRunner::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "perft") == 0) {
+        try {
+            Perft perft(argc - 1, argv + 1);
+            return perft.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Perft::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "enumerate") == 0) {
+        try {
+            Enumerator enumerator(argc - 1, argv + 1);
+            return enumerator.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Enumerator::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "watch") == 0) {
+        try {
+            Watcher watcher(argc - 1, argv + 1);
+            return watcher.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Watcher::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "wall") == 0) {
+        try {
+            Wall wall(argc - 1, argv + 1);
+            return wall.Run();
+        }
+        catch (const char *err) {
+            fprintf(stderr, "%s\n", err);
+            Wall::Usage(name);
+            return 1;
+        }
+    }
+
+    if (strcmp(argv[0], "batch") == 0) {
+        int fd = STDIN_FILENO;
+
+        if (argc > 2) {
+            Usage(name);
+            return 1;
+        }
+        if (argc == 2 && strcmp(argv[1], "-") != 0) {
+            fd = open(argv[1], O_RDONLY);
+            if (fd == -1) {
+                perror(argv[1]);
+                return 1;
+            }
+        }
+
+        return Play(fd);
+    }
+
+    Usage(name);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = argv[0];
+    const char *stats_json = 0;
+    bool stats = false;
+    int res;
+
+    /* Options go before the command */
+    for (argc--, argv++; argc > 0 && argv[0][0] == '-'; argc--, argv++) {
+        if (strcmp(argv[0], "--stats") == 0) { stats = true; }
+        else if (strcmp(argv[0], "--stats-json") == 0 && argc > 1) {
+            stats_json = *++argv;
+            argc--;
+        }
+        else if (strcmp(argv[0], "--seed") == 0 && argc > 1) {
+            Rng::SetDefaultSeed(strtoull(*++argv, 0, 10));
+            argc--;
+        }
+        else if (strcmp(argv[0], "--variant") == 0 && argc > 1) {
+            variant_name = *++argv;
+            argc--;
+        }
+        else if (strcmp(argv[0], "--clock") == 0 && argc > 1) {
+            clock_spec = *++argv;
+            argc--;
+        }
+        else if (strcmp(argv[0], "--publish") == 0 && argc > 1) {
+            publish_name = *++argv;
+            argc--;
+        }
+        else if (strcmp(argv[0], "--trace") == 0 && argc > 1) {
+            Trace::Enable(*++argv);
+            argc--;
+        }
+        else {
+            Usage(name);
+            return 1;
+        }
+    }
+
+    if (stats || stats_json) { Stats::Enable(); }
+
+    res = Command(name, argc, argv);
+
+    if (stats) { Stats::Print(stderr); }
+    if (stats_json && !Stats::WriteJson(stats_json)) { 
+        perror(stats_json); 
+        res = 1;
+    }
+    if (!Trace::Flush()) {
+        perror("trace");
+        res = 1;
+    }
+
+    return res;
+}